@@ -31,8 +31,12 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::bb_pskmod::make is the public interface for
      * creating new instances.
+     *
+     * \param streaming 为 true 时RRC滤波器跨帧连续运行：不再丢弃每帧开头的
+     *        暂态输出，也不再在帧尾补零冲洗，帧尾保护间隔直接取滤波器对零符号的
+     *        响应。符号在帧内的延迟为滤波器群时延（rrc_span/2 个符号）。
      */
-    static sptr make(int hop_rate = 5, int M_order = 4, int Ksa_ch = 4);
+    static sptr make(int hop_rate = 5, int M_order = 4, int Ksa_ch = 4, bool streaming = false);
 };
 
 } // namespace freq_hopping
@@ -31,8 +31,14 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::frame_recover::make is the public interface for
      * creating new instances.
+     *
+     * \param emit_pdu 为 true 时每恢复一帧，就从 "pdus" 消息端口发出一个 PDU：
+     *        car 为元数据字典（offset：帧起点的输入绝对 offset，phase_est，
+     *        corr_est：同位置 corr_est 标签的相关幅度，没有时不写），
+     *        cdr 为 frame_len 个符号的 c32vector。被新标签打断的不完整帧不发出。
+     *        流输出照常工作，也可以不连接
      */
-    static sptr make(int frame_len = 1);
+    static sptr make(int frame_len = 1, bool emit_pdu = false);
 };
 
 } // namespace freq_hopping
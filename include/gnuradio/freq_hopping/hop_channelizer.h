@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_H
+#define INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_H
+
+#include <gnuradio/freq_hopping/api.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 对整个跳频带宽做一次信道化，按时隙选出跳频序列指示的信道
+ * \ingroup freq_hopping
+ *
+ * 与 hop_demod 使用相同的频率表、跳频序列和 rx_time 时间同步，
+ * 但不再为每条链路做全速率混频：整个跳频带宽只做一次基于 FFT 的
+ * 信道化，然后每个输出端口在每个时隙取出对应信道的输出（已抽取 decim 倍）。
+ *
+ * 每个输出端口对应 seq_offsets 中的一项，表示该网络的跳频序列
+ * 相对 hop_mod 的序列偏移的时隙数；默认只有一个偏移为 0 的输出。
+ */
+class FREQ_HOPPING_API hop_channelizer : virtual public gr::sync_decimator
+{
+public:
+    typedef std::shared_ptr<hop_channelizer> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of freq_hopping::hop_channelizer.
+     *
+     * To avoid accidental use of raw pointers, freq_hopping::hop_channelizer's
+     * constructor is in a private implementation
+     * class. freq_hopping::hop_channelizer::make is the public interface for
+     * creating new instances.
+     *
+     * \param bw_hop 跳频带宽（Hz）
+     * \param ch_sep 信道间隔（Hz）
+     * \param freq_carrier 载波中心频率（Hz）
+     * \param fsa_hop 输入采样率（Hz）
+     * \param hop_rate 跳频速率（hops/s）
+     * \param decim 抽取倍数，输出采样率为 fsa_hop/decim
+     * \param seq_offsets 每个输出端口的跳频序列偏移（时隙），不能为负
+     * \param key 跳频图案密钥，收发两端必须相同
+     */
+    static sptr make(double bw_hop = 12000,
+                     double ch_sep = 3000,
+                     double freq_carrier = 0,
+                     double fsa_hop = 12000,
+                     double hop_rate = 5,
+                     int decim = 1,
+                     const std::vector<int>& seq_offsets = std::vector<int>(1, 0),
+                     uint64_t key = hop_plan::DEFAULT_KEY);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_H */
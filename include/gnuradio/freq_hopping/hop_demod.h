@@ -9,7 +9,8 @@
 #define INCLUDED_FREQ_HOPPING_HOP_DEMOD_H
 
 #include <gnuradio/freq_hopping/api.h>
-#include <gnuradio/sync_block.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/sync_decimator.h>
 
 namespace gr {
 namespace freq_hopping {
@@ -19,7 +20,7 @@ namespace freq_hopping {
  * \ingroup freq_hopping
  *
  */
-class FREQ_HOPPING_API hop_demod : virtual public gr::sync_block
+class FREQ_HOPPING_API hop_demod : virtual public gr::sync_decimator
 {
 public:
     typedef std::shared_ptr<hop_demod> sptr;
@@ -31,12 +32,43 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::hop_demod::make is the public interface for
      * creating new instances.
+     *
+     * \param use_phasor_table 为 true 时在构造时为每个信道预计算旋转器相位增量，
+     *        换跳时直接查表，不再计算三角函数
+     * \param decim 解跳后直接多级抽取的倍数，输出采样率为 fsa_hop/decim，
+     *        例如 2457600/(FSY_CH_HOP*4) = 256；为 1 时不抽取
+     * \param simulated_time 为 true 时 tx_time 标签与 rx_time 一样作为时间参考，
+     *        用于 hop_mod 仿真时间模式下的文件/环回流图
+     * \param emit_hop_tags 为 true 时在每个跳频边界（用新信道解跳的第一个输出样点，
+     *        比时隙起点早 0.1 ms）打 hop_start 标签，值为字典 {slot_idx, channel}，
+     *        下游同步头相关可以只在标签附近的小窗口内搜索。锚定后的第一个不完整
+     *        的跳和丢样点之后的跳不打标签
+     * \param key 跳频图案密钥，收发两端必须相同
+     *
+     * 每个时间标签都重新锚定时隙。标签时刻比按上一个锚点推算的时刻晚（USRP
+     * 溢出丢了样点）时，在该位置的输出样点上打 dropped_hops 标签，值为字典
+     * {lost_samples, dropped_hops, slot_idx}，并累加下面的计数器；标签之后的
+     * 样点立即按新时隙解跳，不会影响后面的跳。
      */
     static sptr make(double bw_hop = 12000,
                      double ch_sep = 3000,
                      double freq_carrier = 0,
                      double fsa_hop = 12000,
-                     double hop_rate = 5);
+                     double hop_rate = 5,
+                     bool use_phasor_table = false,
+                     int decim = 1,
+                     bool simulated_time = false,
+                     bool emit_hop_tags = false,
+                     uint64_t key = hop_plan::DEFAULT_KEY);
+
+    //! 检测到的时间不连续次数（时间标签与推算时刻相差半个样点以上）
+    virtual uint64_t discontinuities() const = 0;
+
+    //! 按时间标签推算丢失的输入样点数
+    virtual uint64_t lost_samples() const = 0;
+
+    //! 丢失样点期间经过的时隙数（跨过的跳频边界数）
+    virtual uint64_t dropped_hops() const = 0;
 };
 
 } // namespace freq_hopping
@@ -9,6 +9,8 @@
 #define INCLUDED_FREQ_HOPPING_HOP_MOD_H
 
 #include <gnuradio/freq_hopping/api.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/freq_hopping/time_source.h>
 #include <gnuradio/sync_block.h>
 
 namespace gr {
@@ -31,13 +33,36 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::hop_mod::make is the public interface for
      * creating new instances.
+     *
+     * \param use_phasor_table 为 true 时在构造时为每个信道预计算相量表，
+     *        混频时只做查表复数乘法，不再每跳重设 NCO
+     * \param clock 第一跳对齐所用的时钟，取值见 time_source::source_type。
+     *        DEVICE 时由 "time" 消息端口给出设备时间，收到之前不输出
+     * \param lead_time 第一跳至少比当前时刻晚一个时隙再加 lead_time 秒
+     * \param epoch SIMULATED 时钟的起始时刻（秒，从 epoch 开始）。仿真时间下
+     *        输出样点即时间：第 n 个输出向量的时刻为第一跳时刻加 n 个向量的时长，
+     *        第一跳取 epoch+lead_time 之后的第一个时隙，不留处理余量，
+     *        流图可以不受实时限制全速运行
+     * \param key 跳频图案密钥，收发两端必须相同
      */
     static sptr make(double bw_hop = 12000,
                      double ch_sep = 3000,
                      double freq_carrier = 0,
                      double fsa_hop = 12000,
                      double hop_rate = 5,
-                     int vlen = 1);
+                     int vlen = 1,
+                     bool use_phasor_table = false,
+                     int clock = time_source::HOST,
+                     double lead_time = 0,
+                     double epoch = 0,
+                     uint64_t key = hop_plan::DEFAULT_KEY);
+
+    /*!
+     * \brief 替换第一跳对齐所用的时钟，须在流图启动前调用
+     *
+     * 是否工作在仿真时间下由新时钟的 type() 决定，与构造时的 clock 参数无关。
+     */
+    virtual void set_time_source(time_source::sptr source) = 0;
 
 };
 
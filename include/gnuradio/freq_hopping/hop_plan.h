@@ -0,0 +1,128 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_PLAN_H
+#define INCLUDED_FREQ_HOPPING_HOP_PLAN_H
+
+#include <gnuradio/freq_hopping/api.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+class hop_sequence;
+class phasor_table;
+
+/*!
+ * \brief 收发两端共用的跳频方案
+ * \ingroup freq_hopping
+ *
+ * 集中保存频率表、跳频图案、时隙与时刻的换算以及按需生成的混频相量表，
+ * hop_mod、hop_demod 等块都从这里取值，保证收发两端逐位一致。
+ *
+ * make() 对相同的参数返回同一个对象：同一进程里的多个块实例共享一份
+ * 频率表和相量表，只在第一次创建时计算。对象创建后只读，可在多个线程中使用。
+ */
+class FREQ_HOPPING_API hop_plan
+{
+public:
+    typedef std::shared_ptr<hop_plan> sptr;
+
+    //! 收发两端默认使用的跳频图案密钥
+    static constexpr uint64_t DEFAULT_KEY = 42;
+    //! 一天的纳秒数，时隙号从当天0点开始计
+    static constexpr uint64_t NS_PER_DAY = 24 * 3600 * 1000000000ULL;
+
+    /*!
+     * \brief 取得（必要时创建）与参数对应的跳频方案
+     *
+     * \param bw_hop 跳频带宽（Hz），信道数为 floor(bw_hop/ch_sep)，至少为 1
+     * \param ch_sep 信道间隔（Hz）
+     * \param freq_carrier 载波中心频率（Hz）
+     * \param hop_rate 跳速（跳/秒），110 按 9600/87 处理；其他值按分母不超过
+     *        10^6 的分数精确表示
+     * \param key 跳频图案密钥
+     */
+    static sptr make(double bw_hop,
+                     double ch_sep,
+                     double freq_carrier,
+                     double hop_rate,
+                     uint64_t key = DEFAULT_KEY);
+
+    ~hop_plan();
+
+    int num_channels() const { return static_cast<int>(d_freq_vec.size()); }
+    const std::vector<double>& frequencies() const { return d_freq_vec; }
+    double frequency(int ch) const { return d_freq_vec[ch]; }
+
+    double hop_rate() const { return d_hop_rate; }
+    double hop_period() const { return d_hop_period; }
+    //! 跳速的精确分数表示 rate_num/rate_den（跳/秒），时隙换算都按它进行
+    uint64_t rate_num() const { return d_rate_num; }
+    uint64_t rate_den() const { return d_rate_den; }
+    //! 名义时隙长度（纳秒，截断为整数，仅用于显示）
+    uint64_t slot_ns() const { return d_slot_ns; }
+    uint64_t key() const { return d_key; }
+
+    //! 第 slot 个时隙使用的信道号
+    int channel(uint64_t slot) const;
+    //! 第 slot 个时隙使用的频率（Hz）
+    double slot_frequency(uint64_t slot) const { return d_freq_vec[channel(slot)]; }
+
+    //! rx_time/tx_time 标签的 (整数秒, 小数秒) 转换为纳秒
+    static uint64_t to_ns(uint64_t sec, double frac_sec);
+    //! 距离当天0点的纳秒数
+    static uint64_t ns_since_midnight(uint64_t time_ns) { return time_ns % NS_PER_DAY; }
+
+    //! 时刻 time_ns（从 epoch 开始）所在的时隙号
+    uint64_t slot_index(uint64_t time_ns) const;
+    //! 时刻 time_ns 已进入所在时隙的纳秒数（向下取整）
+    uint64_t slot_offset_ns(uint64_t time_ns) const;
+    //! time_ns 当天第 slot 个时隙的起始时刻（从 epoch 开始，向上取整到纳秒）
+    uint64_t slot_start_ns(uint64_t time_ns, uint64_t slot) const;
+    //! 在 time_ns 时准备发送，第一跳使用的时隙号（至少留出一个完整时隙）
+    uint64_t first_tx_slot(uint64_t time_ns) const;
+    //! 起始时刻不早于 time_ns 的第一个时隙号（仿真时间下不需要留处理余量）
+    uint64_t slot_at_or_after(uint64_t time_ns) const;
+
+    /*!
+     * 采样率 fs 下的信道混频相量表，sign 为 +1（上混频）或 -1（下混频）。
+     * 相同参数只计算一次，由所有调用者共享。
+     */
+    std::shared_ptr<const phasor_table>
+    mixer_table(double fs, int sign, int table_len) const;
+
+private:
+    hop_plan(double bw_hop,
+             double ch_sep,
+             double freq_carrier,
+             double hop_rate,
+             uint64_t key);
+
+    uint64_t d_rate_num;
+    uint64_t d_rate_den;
+    double d_hop_rate;
+    double d_hop_period;
+    uint64_t d_slot_ns;
+    uint64_t d_key;
+    std::vector<double> d_freq_vec;
+    std::unique_ptr<hop_sequence> d_sequence;
+
+    mutable std::mutex d_table_mutex;
+    mutable std::map<std::tuple<double, int, int>, std::shared_ptr<const phasor_table>>
+        d_tables;
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_PLAN_H */
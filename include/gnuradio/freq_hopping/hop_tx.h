@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_TX_H
+#define INCLUDED_FREQ_HOPPING_HOP_TX_H
+
+#include <gnuradio/freq_hopping/api.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/freq_hopping/time_source.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 融合的跳频发送模块：bb_pskmod + hop_interp + hop_mod
+ * \ingroup freq_hopping
+ *
+ * 输入为 slot_frame 输出的一跳符号索引向量，输出为上变频后的一跳样点向量
+ * （长度为 bb_pskmod 输出长度乘以 interp_fac）。星座映射、RRC 成形、
+ * 插值和混频在一次遍历中按小块完成，中间数据留在缓存中，
+ * 不再经过三个模块之间的全速率缓冲区。
+ * 输出与 bb_pskmod -> hop_interp -> hop_mod 链路一致，
+ * 包括第一跳的 tx_time 标签。
+ */
+class FREQ_HOPPING_API hop_tx : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<hop_tx> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of freq_hopping::hop_tx.
+     *
+     * To avoid accidental use of raw pointers, freq_hopping::hop_tx's
+     * constructor is in a private implementation
+     * class. freq_hopping::hop_tx::make is the public interface for
+     * creating new instances.
+     *
+     * \param hop_rate 跳频速率（hops/s）
+     * \param M_order 调制阶数（2、4 或 8）
+     * \param Ksa_ch 每符号样点数
+     * \param interp_fac 基带到跳频采样率的插值倍数
+     * \param bw_hop 跳频带宽（Hz）
+     * \param ch_sep 信道间隔（Hz）
+     * \param freq_carrier 载波中心频率（Hz）
+     * \param fsa_hop 跳频采样率（Hz）
+     * \param clock 第一跳对齐所用的时钟，取值见 time_source::source_type。
+     *        DEVICE 时由 "time" 消息端口给出设备时间，收到之前不输出
+     * \param lead_time 第一跳至少比当前时刻晚一个时隙再加 lead_time 秒
+     * \param epoch SIMULATED 时钟的起始时刻（秒），含义与 hop_mod 相同：
+     *        输出样点即时间，第一跳取 epoch+lead_time 之后的第一个时隙
+     * \param key 跳频图案密钥，收发两端必须相同
+     */
+    static sptr make(int hop_rate = 20,
+                     int M_order = 4,
+                     int Ksa_ch = 4,
+                     int interp_fac = 256,
+                     double bw_hop = 1e6,
+                     double ch_sep = 3e3,
+                     double freq_carrier = 500e3,
+                     double fsa_hop = 2457600,
+                     int clock = time_source::HOST,
+                     double lead_time = 0,
+                     double epoch = 0,
+                     uint64_t key = hop_plan::DEFAULT_KEY);
+
+    /*!
+     * \brief 替换第一跳对齐所用的时钟，须在流图启动前调用
+     *
+     * 是否工作在仿真时间下由新时钟的 type() 决定，与构造时的 clock 参数无关。
+     */
+    virtual void set_time_source(time_source::sptr source) = 0;
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_TX_H */
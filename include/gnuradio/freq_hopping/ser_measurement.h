@@ -10,6 +10,8 @@
 
 #include <gnuradio/block.h>
 #include <gnuradio/freq_hopping/api.h>
+#include <cstdint>
+#include <vector>
 
 namespace gr {
 namespace freq_hopping {
@@ -31,8 +33,41 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::ser_measurement::make is the public interface for
      * creating new instances.
+     *
+     * \param filename 参考符号文件，以只读方式内存映射，不整体读入内存
+     * \param frame_len 每帧符号数。为 0 时整个文件是一帧，每帧都与它比较；
+     *        大于 0 时文件按 frame_len 切成多帧，第 n 个 phase_est 标签之后的数据
+     *        与第 n 帧比较（到文件末尾后回到第 0 帧）。如果同一位置有 frame_num
+     *        标签，则用它的值选择参考帧
+     * \param verbose 为 true 时每 100 帧向 stdout 打印一次统计；统计始终可以通过
+     *        下面的查询函数和 "stats" 消息端口获得
+     */
+    static sptr
+    make(const std::string& filename, int frame_len = 0, bool verbose = false);
+
+    //! 收到的帧数（phase_est 标签数）
+    virtual uint64_t total_frames() const = 0;
+
+    //! 已结束的帧中比较过的符号数
+    virtual uint64_t total_symbols() const = 0;
+
+    //! 已结束的帧中的错误符号数
+    virtual uint64_t total_errors() const = 0;
+
+    //! 最近 100 帧的平均 SER
+    virtual double average_ser() const = 0;
+
+    //! 符号数少于帧长（有符号丢失）的帧数
+    virtual uint64_t short_frames() const = 0;
+
+    //! 两个标签之间符号数多于帧长的帧数
+    virtual uint64_t overlong_frames() const = 0;
+
+    /*!
+     * 每帧 SER 的直方图，6 个区间：[0] SER = 0，[1] (0, 1e-4]，[2] (1e-4, 1e-3]，
+     * [3] (1e-3, 1e-2]，[4] (1e-2, 1e-1]，[5] (1e-1, 1]
      */
-    static sptr make(const std::string& filename);
+    virtual std::vector<uint64_t> ser_histogram() const = 0;
 };
 
 } // namespace freq_hopping
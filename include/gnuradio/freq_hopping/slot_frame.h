@@ -9,7 +9,7 @@
 #define INCLUDED_FREQ_HOPPING_SLOT_FRAME_H
 
 #include <gnuradio/freq_hopping/api.h>
-#include <gnuradio/sync_block.h>
+#include <gnuradio/block.h>
 
 namespace gr {
 namespace freq_hopping {
@@ -19,7 +19,7 @@ namespace freq_hopping {
  * \ingroup freq_hopping
  *
  */
-class FREQ_HOPPING_API slot_frame : virtual public gr::sync_block
+class FREQ_HOPPING_API slot_frame : virtual public gr::block
 {
 public:
     typedef std::shared_ptr<slot_frame> sptr;
@@ -31,8 +31,24 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::slot_frame::make is the public interface for
      * creating new instances.
+     *
+     * \param payload_input 为 true 时增加一个字节流输入，每跳把 num_sym_pld 个
+     *        M 进制符号的比特（高位在前）打包到同步头之后；缓冲中不足一跳时
+     *        发送 info_seed 生成的空闲负载，保证发送端不欠载
+     * \param max_buffered_hops 输入比特缓冲最多容纳的跳数，缓冲满时不再读取输入，
+     *        由上游缓冲区形成背压
      */
-    static sptr make(int hop_rate = 20, int M_order = 4, int info_seed = 0);
+    static sptr make(int hop_rate = 20,
+                     int M_order = 4,
+                     int info_seed = 0,
+                     bool payload_input = false,
+                     int max_buffered_hops = 16);
+
+    //! 携带输入负载发出的跳数
+    virtual uint64_t payload_hops() const = 0;
+
+    //! 因输入不足发出空闲负载的跳数
+    virtual uint64_t idle_hops() const = 0;
 };
 
 } // namespace freq_hopping
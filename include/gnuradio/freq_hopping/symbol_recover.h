@@ -31,8 +31,14 @@ public:
      * constructor is in a private implementation
      * class. freq_hopping::symbol_recover::make is the public interface for
      * creating new instances.
+     *
+     * \param interpolate 为 true 时使用 MMSE 插值做分数定时：在 phase_est 标签处
+     *        用同位置 time_est 标签的小数偏移对准符号中心，之后按 Gardner 环路
+     *        跟踪收发时钟偏差，可以把 sps 降到 2；为 false 时按整数点抽样
+     * \param ted_gain Gardner 定时误差的环路增益，只在 interpolate 为 true 时生效，
+     *        为 0 时只用 time_est 对准、不做跟踪
      */
-    static sptr make(int sps = 1);
+    static sptr make(int sps = 1, bool interpolate = false, float ted_gain = 0.05f);
 };
 
 } // namespace freq_hopping
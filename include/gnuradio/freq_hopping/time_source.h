@@ -0,0 +1,62 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_TIME_SOURCE_H
+#define INCLUDED_FREQ_HOPPING_TIME_SOURCE_H
+
+#include <gnuradio/freq_hopping/api.h>
+#include <cstdint>
+#include <memory>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 发送端时隙对齐使用的时钟
+ * \ingroup freq_hopping
+ *
+ * hop_mod 在第一跳时读取 now_ns()，对齐到下一个时隙后打上 tx_time 标签。
+ * 时刻均为从 epoch 开始的纳秒数。内置三种时钟：
+ *  - HOST：主机 system_clock，受 NTP 抖动和启动延迟影响；
+ *  - DEVICE：设备时间，由 set_time()（或 hop_mod 的 time 消息端口）给出，
+ *    两次设置之间按主机单调时钟外推，收到第一个时间之前无效；
+ *  - SIMULATED：虚拟时钟，只由 set_time() 改变，用于离线仿真，结果可重复。
+ *
+ * 使用时钟的块按 type() 决定是否工作在仿真时间下。
+ */
+class FREQ_HOPPING_API time_source
+{
+public:
+    typedef std::shared_ptr<time_source> sptr;
+
+    enum source_type { HOST = 0, DEVICE = 1, SIMULATED = 2 };
+
+    //! 按类型创建内置时钟，SIMULATED 从 start_ns 开始
+    static sptr make(source_type type, uint64_t start_ns = 0);
+    static sptr make_host();
+    static sptr make_device();
+    static sptr make_simulated(uint64_t start_ns = 0);
+
+    virtual ~time_source();
+
+    //! 当前时刻（纳秒）
+    virtual uint64_t now_ns() = 0;
+
+    //! 时钟类型；跟随真实时间的自定义时钟可保留默认的 HOST
+    virtual source_type type() const { return HOST; }
+
+    //! 是否已有可用的时间（DEVICE 在第一次 set_time 之前为 false）
+    virtual bool valid() const { return true; }
+
+    //! 设置当前时刻；HOST 忽略
+    virtual void set_time(uint64_t time_ns) {}
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_TIME_SOURCE_H */
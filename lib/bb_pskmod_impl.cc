@@ -14,13 +14,13 @@ namespace freq_hopping {
 
 using input_type = int;
 using output_type = gr_complex;
-bb_pskmod::sptr bb_pskmod::make(int hop_rate, int M_order, int Ksa_ch)
+bb_pskmod::sptr bb_pskmod::make(int hop_rate, int M_order, int Ksa_ch, bool streaming)
 {
-    return gnuradio::make_block_sptr<bb_pskmod_impl>(hop_rate, M_order, Ksa_ch);
+    return gnuradio::make_block_sptr<bb_pskmod_impl>(hop_rate, M_order, Ksa_ch, streaming);
 }
 
 
-bb_pskmod_impl::bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch)
+bb_pskmod_impl::bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch, bool streaming)
     : gr::sync_block("bb_pskmod",
                      gr::io_signature::make(
                          1, 1, sizeof(input_type) * calculate_input_length(hop_rate)),
@@ -31,6 +31,10 @@ bb_pskmod_impl::bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch)
     d_Ksa_ch(Ksa_ch),
     rrc_span(0),
     d_rrc_filter(nullptr),
+    d_streaming(streaming),
+    d_flush_syms(0),
+    d_zero_run(0),
+    d_carry_len(0),
     d_initialized(false)
 {
     // 验证参数
@@ -55,6 +59,27 @@ bb_pskmod_impl::bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch)
     // 设计RRC滤波器
     design_rrc_filter();
 
+    // 成形输出（每帧 d_input_frame_len*d_Ksa_ch 个样点）必须放得进输出帧
+    if (d_output_frame_len < d_input_frame_len * d_Ksa_ch) {
+        throw std::invalid_argument("output frame is shorter than the shaped input frame");
+    }
+
+    // 符号缓冲：整帧符号后面接零符号，用于冲洗滤波器
+    int num_sym_transition = (rrc_span >> 1) - 1;
+    d_flush_syms = (d_rrc_taps.size() + d_Ksa_ch - 1) / d_Ksa_ch;
+    d_sym_buf.assign(d_input_frame_len + std::max(num_sym_transition, d_flush_syms),
+                     gr_complex(0, 0));
+    d_transition_out.resize(num_sym_transition * d_Ksa_ch);
+
+    // 流式模式下帧尾保护间隔不足一个符号的部分由下一帧接着输出
+    if (d_streaming) {
+        if (d_output_frame_len < (d_input_frame_len + 1) * d_Ksa_ch - 1) {
+            throw std::invalid_argument("guard interval too short for streaming mode");
+        }
+        d_carry.resize(d_Ksa_ch);
+        d_zero_run = d_flush_syms;
+    }
+
     d_initialized = true;
     // set_history(3);
 }
@@ -66,21 +91,21 @@ bb_pskmod_impl::~bb_pskmod_impl()
     }
 }
 
-void bb_pskmod_impl::initialize_constellation()
+std::vector<gr_complex> bb_pskmod_impl::make_constellation(int M_order)
 {
-    d_constellation.clear();
+    std::vector<gr_complex> constellation;
     float cos_pi_4 = std::cos(M_PI_4f);
 
-    switch (d_M_order) {
+    switch (M_order) {
         case 2:  // BPSK
-            d_constellation = {
+            constellation = {
             gr_complex(1.0f, 0.0f),   // 0: 1+0j
             gr_complex(-1.0f, 0.0f)   // 1: -1+0j
         };
         break;
 
         case 4:
-            d_constellation = {
+            constellation = {
             gr_complex(1.0f, 0.0f),
             gr_complex(0.0f, 1.0f),
             gr_complex(0.0f, -1.0f),
@@ -89,7 +114,7 @@ void bb_pskmod_impl::initialize_constellation()
         break;
 
         case 8:
-            d_constellation = {
+            constellation = {
             gr_complex(1.0f, 0.0f),
             gr_complex(cos_pi_4, cos_pi_4),
             gr_complex(-cos_pi_4, cos_pi_4),
@@ -102,43 +127,114 @@ void bb_pskmod_impl::initialize_constellation()
         break;
 
         default:  // 4/8PSK
-            for (int i = 0; i < d_M_order; ++i) {
-                float phase = 2.0f * M_PI * i / d_M_order;
-                d_constellation.push_back(gr_complex(std::cos(phase), std::sin(phase)));
+            for (int i = 0; i < M_order; ++i) {
+                float phase = 2.0f * M_PI * i / M_order;
+                constellation.push_back(gr_complex(std::cos(phase), std::sin(phase)));
             }
     }
+    return constellation;
 }
 
-void bb_pskmod_impl::design_rrc_filter()
+std::vector<float> bb_pskmod_impl::design_rrc_taps(int Ksa_ch, int span)
 {
     // RRC滤波器参数
-    rrc_span = 8;
-    const float rolloff = 0.25f;      // 滚降因子
-    const int ntaps = rrc_span * d_Ksa_ch + 1; // 滤波器抽头数
+    const float rolloff = 0.25f;          // 滚降因子
+    const int ntaps = span * Ksa_ch + 1;  // 滤波器抽头数
 
     // 设计根升余弦滤波器
-    d_rrc_taps = gr::filter::firdes::root_raised_cosine(
+    return gr::filter::firdes::root_raised_cosine(
         1.0,    // 增益
-        d_Ksa_ch,    // 采样率 (符号率的Ksa_ch倍)
+        Ksa_ch,    // 采样率 (符号率的Ksa_ch倍)
         1.0,        // 符号率
         rolloff,     // 滚降因子
         ntaps        // 抽头数
     );
+}
+
+void bb_pskmod_impl::initialize_constellation()
+{
+    d_constellation = make_constellation(d_M_order);
+}
+
+void bb_pskmod_impl::design_rrc_filter()
+{
+    rrc_span = 8;
+    d_rrc_taps = design_rrc_taps(d_Ksa_ch, rrc_span);
 
     // 重新创建滤波器
     if (d_rrc_filter) {
         firinterp_crcf_destroy(d_rrc_filter);
     }
-    d_rrc_filter = firinterp_crcf_create(d_Ksa_ch,d_rrc_taps.data(),ntaps);
+    d_rrc_filter = firinterp_crcf_create(d_Ksa_ch, d_rrc_taps.data(), d_rrc_taps.size());
 }
 
-gr_complex bb_pskmod_impl::map_to_constellation(int symbol_index)
+void bb_pskmod_impl::map_frame(const int* frame_in)
 {
-    if (symbol_index < 0 || symbol_index >= static_cast<int>(d_constellation.size())) {
-        // 错误处理：返回第一个星座点
-        return d_constellation[0];
+    // 查表映射整帧；越界的符号索引（按无符号比较，负数也越界）映射到第一个星座点
+    const unsigned M = d_constellation.size();
+    for (int i = 0; i < d_input_frame_len; ++i) {
+        unsigned idx = static_cast<unsigned>(frame_in[i]);
+        d_sym_buf[i] = d_constellation[idx < M ? idx : 0];
+    }
+}
+
+void bb_pskmod_impl::modulate_frame_reset(gr_complex* frame_out)
+{
+    const int num_sym_transition = (rrc_span >> 1) - 1;
+    const int shaped_len = d_input_frame_len * d_Ksa_ch;
+
+    // 第一阶段：前num_sym_transition个符号的输出是滤波器暂态，丢弃
+    firinterp_crcf_execute_block(
+        d_rrc_filter, d_sym_buf.data(), num_sym_transition, d_transition_out.data());
+
+    // 第二、三阶段：其余符号和帧尾的num_sym_transition个零符号，整块直接写入输出
+    firinterp_crcf_execute_block(
+        d_rrc_filter, d_sym_buf.data() + num_sym_transition, d_input_frame_len, frame_out);
+
+    // 只有成形输出之后的剩余部分需要填0
+    std::fill(frame_out + shaped_len, frame_out + d_output_frame_len, gr_complex(0, 0));
+}
+
+void bb_pskmod_impl::push_guard(int n, gr_complex* out)
+{
+    // 滤波器中还有非零符号时才需要真正送入零符号
+    int npush = std::max(0, std::min(n, d_flush_syms - d_zero_run));
+    if (npush > 0) {
+        firinterp_crcf_execute_block(
+            d_rrc_filter, d_sym_buf.data() + d_input_frame_len, npush, out);
+    }
+    std::fill(out + npush * d_Ksa_ch, out + n * d_Ksa_ch, gr_complex(0, 0));
+    d_zero_run += n;
+}
+
+void bb_pskmod_impl::modulate_frame_streaming(gr_complex* frame_out)
+{
+    // 上一帧多出的半个符号的输出放在本帧开头
+    gr_complex* p = frame_out;
+    std::copy(d_carry.begin(), d_carry.begin() + d_carry_len, p);
+    p += d_carry_len;
+    int remaining = d_output_frame_len - d_carry_len;
+
+    // 数据符号整块送入，输出紧接着写入
+    firinterp_crcf_execute_block(d_rrc_filter, d_sym_buf.data(), d_input_frame_len, p);
+    p += d_input_frame_len * d_Ksa_ch;
+    remaining -= d_input_frame_len * d_Ksa_ch;
+    d_zero_run = 0;
+
+    // 保护间隔：整符号部分直接写入输出
+    int nguard = remaining / d_Ksa_ch;
+    push_guard(nguard, p);
+    p += nguard * d_Ksa_ch;
+    remaining -= nguard * d_Ksa_ch;
+
+    // 不足一个符号的部分：再送一个零符号，多出的输出留给下一帧
+    d_carry_len = 0;
+    if (remaining > 0) {
+        push_guard(1, d_carry.data());
+        std::copy(d_carry.begin(), d_carry.begin() + remaining, p);
+        std::copy(d_carry.begin() + remaining, d_carry.end(), d_carry.begin());
+        d_carry_len = d_Ksa_ch - remaining;
     }
-    return d_constellation[symbol_index];
 }
 
 int bb_pskmod_impl::work(int noutput_items,
@@ -163,42 +259,23 @@ int bb_pskmod_impl::work(int noutput_items,
     // printf("bb_pskmod_impl::work, in[(noutput_items+history()-2)*d_input_frame_len]: %d\n",in[(noutput_items+history()-2)*d_input_frame_len]);
     // printf("bb_pskmod_impl::work, in[(noutput_items+history()-2)*d_input_frame_len+1]: %d\n",in[(noutput_items+history()-2)*d_input_frame_len+1]);
 
-    // 首先将out@(noutput_items*d_output_frame_length)全部填0
-    memset(out, 0, noutput_items * d_output_frame_len * sizeof(output_type));
-
     if (!d_initialized) {
         return 0;
     }
 
     int idx_frame = 0;
-    int num_sym_transition = (rrc_span>>1)-1;
-    output_type transition_out[d_Ksa_ch];
     for (; idx_frame < noutput_items; ++idx_frame) {
         const input_type* frame_in = in + idx_frame * d_input_frame_len;
         output_type* frame_out = out + idx_frame * d_output_frame_len;
 
+        // 整帧查表映射到 d_sym_buf
+        map_frame(frame_in);
 
-        int idx_in_sym = 0;
-        // 第一阶段：处理前num_sym_transition个符号，输出到transition_out（不使用）
-        for (; idx_in_sym < num_sym_transition; ++idx_in_sym) {
-            gr_complex symbol = map_to_constellation(frame_in[idx_in_sym]);
-            firinterp_crcf_execute(d_rrc_filter, symbol, transition_out);
+        if (d_streaming) {
+            modulate_frame_streaming(frame_out);
+        } else {
+            modulate_frame_reset(frame_out);
         }
-
-        // 第二阶段：处理接下来的符号，直到输入帧的末尾
-        for (; idx_in_sym < d_input_frame_len; ++idx_in_sym) {
-            gr_complex symbol = map_to_constellation(frame_in[idx_in_sym]);
-            // 计算输出位置：当前输出符号索引是(idx_in_sym - num_sym_transition)，所以乘以d_Ksa_ch
-            firinterp_crcf_execute(d_rrc_filter, symbol, &frame_out[(idx_in_sym - num_sym_transition) * d_Ksa_ch]);
-        }
-
-        // 第三阶段：输入0，继续产生num_sym_transition个符号的输出（每个符号d_Ksa_ch个样本）
-        for (int i = 0; i < num_sym_transition; ++i) {
-            gr_complex zero(0.0f, 0.0f);
-            // 输出位置从第二阶段结束的位置开始，即(d_input_frame_len - num_sym_transition) * d_Ksa_ch，然后每次递增d_Ksa_ch
-            firinterp_crcf_execute(d_rrc_filter, zero, &frame_out[(d_input_frame_len - num_sym_transition) * d_Ksa_ch + i * d_Ksa_ch]);
-        }
-
     }
 
     return idx_frame;
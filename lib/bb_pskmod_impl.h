@@ -40,14 +40,34 @@ private:
     std::vector<float> d_rrc_taps;
     firinterp_crcf d_rrc_filter;
 
+    // 每帧的符号缓冲和丢弃的暂态输出
+    std::vector<gr_complex> d_sym_buf;
+    std::vector<gr_complex> d_transition_out;
+
+    // 流式模式（跨帧连续滤波）
+    bool d_streaming;
+    int d_flush_syms;                // 冲洗滤波器所需的零符号数
+    int d_zero_run;                  // 最近连续送入（或跳过）的零符号数
+    std::vector<gr_complex> d_carry; // 上一帧末尾多出的半个符号的输出
+    int d_carry_len;
+
     bool d_initialized;
 
     void initialize_constellation();
     void design_rrc_filter();
-    gr_complex map_to_constellation(int symbol_index);
+    void map_frame(const int* frame_in);
+    void modulate_frame_reset(gr_complex* frame_out);
+    void modulate_frame_streaming(gr_complex* frame_out);
+    // 送入 n 个零符号的保护间隔，滤波器已冲洗干净后直接填0
+    void push_guard(int n, gr_complex* out);
 
 public:
-    bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch);
+    bb_pskmod_impl(int hop_rate, int M_order, int Ksa_ch, bool streaming);
+
+    // 星座图和RRC成形滤波器的设计，hop_tx 与本模块共用
+    static std::vector<gr_complex> make_constellation(int M_order);
+    static std::vector<float> design_rrc_taps(int Ksa_ch, int span);
+
     ~bb_pskmod_impl();
 
     // Where all the action really happens
@@ -0,0 +1,184 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "cascade_resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+// 输入信号占用的单边带宽（相对输入采样率）
+static const float CASCADE_SIGNAL_BW = 0.4f;
+
+// 计算倍数为 M 的一级所需的半长 m。F 为该级低采样率一侧相对信号采样率的倍数：
+// 插值时是该级的输入采样率，抽取时是该级的输出采样率
+static unsigned cascade_stage_m(int M, int F, float As)
+{
+    // 高采样率 F*M 下的通带边缘 0.4/(F*M)，阻带边缘 (F-0.4)/(F*M)
+    float df = (F - 2 * CASCADE_SIGNAL_BW) / (F * M);
+    unsigned h_len = estimate_req_filter_len(df, As);
+    // 滤波器长度为 2*M*m+1
+    unsigned m = static_cast<unsigned>(std::ceil((h_len - 1) / (2.0 * M)));
+    return std::max(m, 1u);
+}
+
+// Kaiser 窗低通，截止频率 0.5/M，系数之和归一化为 gain
+static std::vector<float> cascade_stage_taps(int M, int F, float As, float gain)
+{
+    unsigned h_len = 2 * M * cascade_stage_m(M, F, As) + 1;
+    std::vector<float> h(h_len);
+    liquid_firdes_kaiser(h_len, 0.5f / M, As, 0.0f, h.data());
+    float sum = 0;
+    for (float v : h) {
+        sum += v;
+    }
+    for (float& v : h) {
+        v *= gain / sum;
+    }
+    return h;
+}
+
+// 把倍数分解为奇数 r 和 k 个 2，odd_first 决定奇数级在前还是在后
+static std::vector<int> cascade_factors(int factor, bool odd_first)
+{
+    int r = factor;
+    int k = 0;
+    while (r % 2 == 0) {
+        r /= 2;
+        ++k;
+    }
+    std::vector<int> factors(k, 2);
+    if (r > 1) {
+        factors.insert(odd_first ? factors.begin() : factors.end(), r);
+    }
+    return factors;
+}
+
+cascade_interpolator::cascade_interpolator(int interp, float As) : d_interp(interp)
+{
+    if (d_interp < 1) {
+        throw std::invalid_argument("interp must be at least 1");
+    }
+
+    // 分解为 r * 2^k，奇数倍放在采样率最低的第一级
+    d_factors = cascade_factors(d_interp, true);
+
+    // 每个多相分支增益为 1
+    int F = 1;
+    for (int M : d_factors) {
+        auto h = cascade_stage_taps(M, F, As, M);
+        d_stages.push_back(firinterp_crcf_create(M, h.data(), h.size()));
+        F *= M;
+    }
+}
+
+cascade_interpolator::~cascade_interpolator()
+{
+    for (auto q : d_stages) {
+        firinterp_crcf_destroy(q);
+    }
+}
+
+void cascade_interpolator::reset()
+{
+    for (auto q : d_stages) {
+        firinterp_crcf_reset(q);
+    }
+}
+
+void cascade_interpolator::execute(const gr_complex* in, int n, gr_complex* out)
+{
+    if (d_stages.empty()) {
+        std::copy(in, in + n, out);
+        return;
+    }
+
+    // 中间级在两个缓冲间交替，最后一级直接写入 out
+    const gr_complex* x = in;
+    int len = n;
+    for (size_t i = 0; i < d_stages.size(); ++i) {
+        gr_complex* y;
+        if (i + 1 == d_stages.size()) {
+            y = out;
+        } else {
+            auto& buf = d_buf[i % 2];
+            if (buf.size() < static_cast<size_t>(len * d_factors[i])) {
+                buf.resize(len * d_factors[i]);
+            }
+            y = buf.data();
+        }
+        firinterp_crcf_execute_block(d_stages[i], const_cast<gr_complex*>(x), len, y);
+        x = y;
+        len *= d_factors[i];
+    }
+}
+
+cascade_decimator::cascade_decimator(int decim, float As) : d_decim(decim)
+{
+    if (d_decim < 1) {
+        throw std::invalid_argument("decim must be at least 1");
+    }
+
+    // 分解为 2^k * r，奇数倍放在采样率最低的最后一级
+    d_factors = cascade_factors(d_decim, false);
+
+    // 从最后一级往前，F 为各级输出采样率相对最终输出采样率的倍数
+    std::vector<firdecim_crcf> stages;
+    int F = 1;
+    for (auto it = d_factors.rbegin(); it != d_factors.rend(); ++it) {
+        auto h = cascade_stage_taps(*it, F, As, 1.0f);
+        stages.push_back(firdecim_crcf_create(*it, h.data(), h.size()));
+        F *= *it;
+    }
+    d_stages.assign(stages.rbegin(), stages.rend());
+}
+
+cascade_decimator::~cascade_decimator()
+{
+    for (auto q : d_stages) {
+        firdecim_crcf_destroy(q);
+    }
+}
+
+void cascade_decimator::reset()
+{
+    for (auto q : d_stages) {
+        firdecim_crcf_reset(q);
+    }
+}
+
+void cascade_decimator::execute(const gr_complex* in, int n, gr_complex* out)
+{
+    if (d_stages.empty()) {
+        std::copy(in, in + n, out);
+        return;
+    }
+
+    // 中间级在两个缓冲间交替，最后一级直接写入 out
+    const gr_complex* x = in;
+    int len = n * d_decim;
+    for (size_t i = 0; i < d_stages.size(); ++i) {
+        len /= d_factors[i];
+        gr_complex* y;
+        if (i + 1 == d_stages.size()) {
+            y = out;
+        } else {
+            auto& buf = d_buf[i % 2];
+            if (buf.size() < static_cast<size_t>(len)) {
+                buf.resize(len);
+            }
+            y = buf.data();
+        }
+        firdecim_crcf_execute_block(d_stages[i], const_cast<gr_complex*>(x), len, y);
+        x = y;
+    }
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
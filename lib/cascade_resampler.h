@@ -0,0 +1,90 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_CASCADE_RESAMPLER_H
+#define INCLUDED_FREQ_HOPPING_CASCADE_RESAMPLER_H
+
+#include <gnuradio/gr_complex.h>
+#include <liquid/liquid.h>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 多级整数倍插值器
+ *
+ * 把插值倍数分解为 r * 2^k（r 为奇数）：先以奇数倍 r 插值，
+ * 再级联 k 个 2 倍插值。每一级都是 Kaiser 窗设计的多相插值器（firinterp），
+ * 滤波器长度按该级的过渡带宽度估计：越靠后的级信号占用的相对带宽越窄，
+ * 过渡带越宽，滤波器越短。与单级插值相比每个输出样点的乘加次数少得多。
+ *
+ * 假设输入信号位于输入采样率的 ±0.4 以内，各级阻带衰减为 As，
+ * 通带增益为 1。
+ */
+class cascade_interpolator
+{
+private:
+    int d_interp;
+    std::vector<int> d_factors;
+    std::vector<firinterp_crcf> d_stages;
+    std::vector<gr_complex> d_buf[2];
+
+public:
+    cascade_interpolator(int interp, float As = 60.0f);
+    ~cascade_interpolator();
+
+    cascade_interpolator(const cascade_interpolator&) = delete;
+    cascade_interpolator& operator=(const cascade_interpolator&) = delete;
+
+    int interp() const { return d_interp; }
+    int num_stages() const { return d_stages.size(); }
+
+    //! 清空各级滤波器的状态
+    void reset();
+
+    //! 插值 n 个输入样点，out 中写入 n * interp() 个样点
+    void execute(const gr_complex* in, int n, gr_complex* out);
+};
+
+/*!
+ * \brief 多级整数倍抽取器
+ *
+ * 与 cascade_interpolator 对称：抽取倍数分解为 2^k * r，
+ * 先在高采样率下级联 k 个 2 倍抽取，最后以奇数倍 r 抽取。
+ * 假设需要保留的信号位于输出采样率的 ±0.4 以内，
+ * 各级按混叠到该频带的阻带衰减 As 设计，通带增益为 1。
+ */
+class cascade_decimator
+{
+private:
+    int d_decim;
+    std::vector<int> d_factors;
+    std::vector<firdecim_crcf> d_stages;
+    std::vector<gr_complex> d_buf[2];
+
+public:
+    cascade_decimator(int decim, float As = 60.0f);
+    ~cascade_decimator();
+
+    cascade_decimator(const cascade_decimator&) = delete;
+    cascade_decimator& operator=(const cascade_decimator&) = delete;
+
+    int decim() const { return d_decim; }
+    int num_stages() const { return d_stages.size(); }
+
+    //! 清空各级滤波器的状态
+    void reset();
+
+    //! 产生 n 个输出样点，in 中需要 n * decim() 个输入样点
+    void execute(const gr_complex* in, int n, gr_complex* out);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_CASCADE_RESAMPLER_H */
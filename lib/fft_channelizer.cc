@@ -0,0 +1,134 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "fft_channelizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+fft_channelizer::fft_channelizer(
+    double fs, int decim, int nfft_ch, double passband, double stopband)
+    : d_fs(fs),
+      d_decim(decim),
+      d_nfft_ch(nfft_ch),
+      d_nfft(nfft_ch * decim),
+      d_fft(nullptr),
+      d_ifft(nullptr)
+{
+    if (d_fs <= 0) {
+        throw std::invalid_argument("fft_channelizer: fs must be positive");
+    }
+    if (d_decim < 1) {
+        throw std::invalid_argument("fft_channelizer: decim must be at least 1");
+    }
+    if (d_nfft_ch < 4 || d_nfft_ch % 4 != 0) {
+        throw std::invalid_argument("fft_channelizer: nfft_ch must be a multiple of 4");
+    }
+    if (passband <= 0 || stopband < passband) {
+        throw std::invalid_argument("fft_channelizer: invalid passband/stopband");
+    }
+    if (stopband > 0.5 * d_fs / d_decim) {
+        throw std::invalid_argument(
+            "fft_channelizer: stopband exceeds the output Nyquist frequency");
+    }
+
+    // 频域滤波器：通带为 1，过渡带为升余弦，并包含 FFT/IFFT 的 1/N 归一化
+    double bin_hz = d_fs / d_nfft;
+    d_mask.resize(d_nfft_ch);
+    for (int q = 0; q < d_nfft_ch; ++q) {
+        double f = std::fabs((q - d_nfft_ch / 2) * bin_hz);
+        double gain;
+        if (f <= passband) {
+            gain = 1.0;
+        } else if (f >= stopband) {
+            gain = 0.0;
+        } else {
+            gain = 0.5 * (1.0 + std::cos(M_PI * (f - passband) / (stopband - passband)));
+        }
+        d_mask[q] = static_cast<float>(gain / d_nfft);
+    }
+
+    d_fft_in.resize(d_nfft);
+    d_fft_out.resize(d_nfft);
+    d_ifft_in.resize(d_nfft_ch);
+    d_ifft_out.resize(d_nfft_ch);
+    d_fft = fft_create_plan(
+        d_nfft, d_fft_in.data(), d_fft_out.data(), LIQUID_FFT_FORWARD, 0);
+    d_ifft = fft_create_plan(
+        d_nfft_ch, d_ifft_in.data(), d_ifft_out.data(), LIQUID_FFT_BACKWARD, 0);
+}
+
+fft_channelizer::~fft_channelizer()
+{
+    if (d_fft) {
+        fft_destroy_plan(d_fft);
+    }
+    if (d_ifft) {
+        fft_destroy_plan(d_ifft);
+    }
+}
+
+int fft_channelizer::choose_nfft_ch(double fs, int decim, double resolution)
+{
+    int nfft_ch = 16;
+    while (fs / (static_cast<double>(nfft_ch) * decim) > resolution) {
+        nfft_ch <<= 1;
+    }
+    return nfft_ch;
+}
+
+void fft_channelizer::execute(const gr_complex* window)
+{
+    memcpy(d_fft_in.data(), window, d_nfft * sizeof(gr_complex));
+    fft_execute(d_fft);
+}
+
+void fft_channelizer::extract(double freq, uint64_t block_idx, gr_complex* out)
+{
+    // 最近的 FFT 频点及剩余频偏
+    double bin_exact = freq * d_nfft / d_fs;
+    int64_t bin = static_cast<int64_t>(std::llround(bin_exact));
+    double residual = freq - bin * d_fs / d_nfft;
+    int64_t bin_mod = ((bin % d_nfft) + d_nfft) % d_nfft;
+
+    // 取出以 bin 为中心的 nfft_ch 个频点并加窗，频偏 k 放到 IFFT 的 k mod nfft_ch 位置
+    for (int q = 0; q < d_nfft_ch; ++q) {
+        int k = q - d_nfft_ch / 2;
+        int64_t src = (bin_mod + k + d_nfft) % d_nfft;
+        int dst = (k + d_nfft_ch) % d_nfft_ch;
+        d_ifft_in[dst] = d_fft_out[src] * d_mask[q];
+    }
+    fft_execute(d_ifft);
+
+    // 频点搬移以窗口起点 s = B*N/2 - N/2 为相位参考，换算到绝对时间 0：
+    // exp(-j*2*pi*bin*s/N) = (-1)^(bin*(B-1))
+    bool flip = ((bin_mod & 1) != 0) && (((block_idx + 1) & 1) != 0);
+
+    // 剩余频偏在输出速率上补偿，起始相位按绝对时间计算
+    int keep = d_nfft_ch / 4;
+    double t0 = static_cast<double>(block_idx) * (d_nfft / 2) - d_nfft / 4;
+    double cycles = residual * t0 / d_fs;
+    cycles -= std::floor(cycles);
+    gr_complex phase = std::polar(1.0f, static_cast<float>(-2 * M_PI * cycles));
+    if (flip) {
+        phase = -phase;
+    }
+    gr_complex step =
+        std::polar(1.0f, static_cast<float>(-2 * M_PI * residual * d_decim / d_fs));
+
+    for (int j = 0; j < block_out(); ++j) {
+        out[j] = d_ifft_out[keep + j] * phase;
+        phase *= step;
+    }
+}
+
+} // namespace freq_hopping
+} // namespace gr
@@ -0,0 +1,89 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_FFT_CHANNELIZER_H
+#define INCLUDED_FREQ_HOPPING_FFT_CHANNELIZER_H
+
+#include <gnuradio/gr_complex.h>
+#include <liquid/liquid.h>
+#include <cstdint>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 基于 FFT 的重叠保留（fast-convolution）分析信道化器
+ *
+ * 每个块对 N = nfft_ch * decim 个输入样点做一次 N 点 FFT（50% 重叠），
+ * 之后任意信道只需取出中心频率附近的 nfft_ch 个频点、乘以频域滤波器、
+ * 做一次 nfft_ch 点 IFFT，即得到该信道抽取 decim 倍后的基带输出。
+ *
+ * 信道中心不必落在 FFT 频点上：剩余的频偏在低速率输出端用旋转补偿，
+ * 因此信道间隔、载波频率与采样率之间不需要整数关系。
+ *
+ * 块的编号 B 为绝对编号：第 B 块的输入窗口为 [B*L - N/2, B*L + N/2)，
+ * 输出的第 j 个样点对应输入样点 B*L - N/4 + j*decim（L = N/2）。
+ */
+class fft_channelizer
+{
+private:
+    double d_fs;
+    int d_decim;
+    int d_nfft_ch; // 每信道 IFFT 点数
+    int d_nfft;    // 输入 FFT 点数
+
+    std::vector<float> d_mask; // 频域滤波器，长度 d_nfft_ch，按频偏 -nfft_ch/2..nfft_ch/2-1 排列
+
+    std::vector<gr_complex> d_fft_in;
+    std::vector<gr_complex> d_fft_out;
+    std::vector<gr_complex> d_ifft_in;
+    std::vector<gr_complex> d_ifft_out;
+    fftplan d_fft;
+    fftplan d_ifft;
+
+public:
+    /*!
+     * \param fs 输入采样率（Hz）
+     * \param decim 抽取倍数，输出采样率为 fs/decim
+     * \param nfft_ch 每信道 IFFT 点数，必须是 4 的倍数
+     * \param passband 通带半宽（Hz）
+     * \param stopband 阻带起始频率（Hz），通带到阻带之间为升余弦过渡
+     */
+    fft_channelizer(double fs, int decim, int nfft_ch, double passband, double stopband);
+    ~fft_channelizer();
+
+    fft_channelizer(const fft_channelizer&) = delete;
+    fft_channelizer& operator=(const fft_channelizer&) = delete;
+
+    //! 输入 FFT 点数 N
+    int fft_size() const { return d_nfft; }
+    //! 每块新输入的样点数 L = N/2
+    int block_in() const { return d_nfft / 2; }
+    //! 每块每信道的输出样点数 L/decim
+    int block_out() const { return d_nfft_ch / 2; }
+    //! 输出相对输入的时延（输入样点）
+    int delay() const { return d_nfft / 4; }
+
+    //! 对长度为 fft_size() 的输入窗口做 FFT
+    void execute(const gr_complex* window);
+
+    /*!
+     * 从最近一次 execute() 的结果中取出中心频率为 freq 的信道，
+     * 输出 block_out() 个样点。block_idx 为该块的绝对编号 B，
+     * 用于保证跨块的相位连续。
+     */
+    void extract(double freq, uint64_t block_idx, gr_complex* out);
+
+    //! 根据采样率、抽取倍数和所需频率分辨率选择 nfft_ch（2 的幂，至少 16）
+    static int choose_nfft_ch(double fs, int decim, double resolution);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_FFT_CHANNELIZER_H */
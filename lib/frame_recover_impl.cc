@@ -1,29 +1,67 @@
 #include "frame_recover_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 namespace gr {
   namespace freq_hopping {
 
     frame_recover::sptr
-    frame_recover::make(int frame_len)
+    frame_recover::make(int frame_len, bool emit_pdu)
     {
-      return gnuradio::make_block_sptr<frame_recover_impl>(frame_len);
+      return gnuradio::make_block_sptr<frame_recover_impl>(frame_len, emit_pdu);
     }
 
-    frame_recover_impl::frame_recover_impl(int frame_len)
+    frame_recover_impl::frame_recover_impl(int frame_len, bool emit_pdu)
       : gr::block("frame_recover",
               gr::io_signature::make(1, 1, sizeof(gr_complex)),
               gr::io_signature::make(0, 1, sizeof(gr_complex))), // 输出可以为0
         d_frame_len(frame_len),
         d_count(0),
-        d_is_active(false)
+        d_is_active(false),
+        d_emit_pdu(emit_pdu),
+        d_corr_key(pmt::mp("corr_est")),
+        d_pdu_port(pmt::mp("pdus")),
+        d_pdu_meta(pmt::make_dict())
     {
+        if (frame_len < 1) {
+            throw std::invalid_argument("frame_recover: frame_len must be >= 1");
+        }
         d_tag_key = pmt::mp("phase_est");
         set_tag_propagation_policy(TPP_DONT);
+
+        message_port_register_out(d_pdu_port);
+        if (d_emit_pdu) {
+            d_pdu_buf.reserve(d_frame_len);
+        }
     }
 
     frame_recover_impl::~frame_recover_impl() {}
 
+    void frame_recover_impl::start_pdu(const tag_t& tag, const std::vector<tag_t>& tags_corr)
+    {
+        // 新标签开始新的一帧，之前未完成的帧直接丢弃
+        d_pdu_buf.clear();
+
+        pmt::pmt_t meta = pmt::make_dict();
+        meta = pmt::dict_add(meta, pmt::mp("offset"), pmt::from_uint64(tag.offset));
+        meta = pmt::dict_add(meta, d_tag_key, tag.value);
+        auto corr_it = std::lower_bound(tags_corr.begin(), tags_corr.end(), tag.offset,
+                                        [](const tag_t& t, uint64_t off) { return t.offset < off; });
+        if (corr_it != tags_corr.end() && corr_it->offset == tag.offset) {
+            meta = pmt::dict_add(meta, d_corr_key, corr_it->value);
+        }
+        d_pdu_meta = meta;
+    }
+
+    void frame_recover_impl::publish_pdu()
+    {
+        pmt::pmt_t vec = pmt::init_c32vector(d_pdu_buf.size(), d_pdu_buf.data());
+        message_port_pub(d_pdu_port, pmt::cons(d_pdu_meta, vec));
+        d_pdu_buf.clear();
+    }
+
     void frame_recover_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
     {
         // 即使没有输出，也需要输入来检测标签，所以至少需要 noutput 个输入
@@ -36,48 +74,79 @@ namespace gr {
                                          gr_vector_void_star &output_items)
     {
         const gr_complex *in = (const gr_complex *)input_items[0];
-        gr_complex *out = (gr_complex *)output_items[0];
+        // 只用 PDU 时流输出可以不连接
+        gr_complex *out = output_items.empty() ? nullptr : (gr_complex *)output_items[0];
 
         int ninput = ninput_items[0];
         int nproduced = 0;
 
         // 获取当前范围内的标签
-        std::vector<tag_t> tags;
+        std::vector<tag_t> tags, tags_corr;
         get_tags_in_range(tags, 0, nitems_read(0), nitems_read(0) + ninput, d_tag_key);
+        if (d_emit_pdu) {
+            get_tags_in_range(tags_corr, 0, nitems_read(0), nitems_read(0) + ninput, d_corr_key);
+            std::sort(tags_corr.begin(), tags_corr.end(), [](const tag_t &a, const tag_t &b) {
+                return a.offset < b.offset;
+            });
+        }
         auto tag_it = tags.begin();
+        const uint64_t n0 = nitems_read(0);
 
-        for (int i = 0; i < ninput; ++i) {
-            uint64_t abs_offset_in = nitems_read(0) + i;
+        // 按标签计算激活窗口：窗口内整段 memcpy，窗口外整段跳过（丢弃）
+        int i = 0;
+        while (i < ninput) {
+            int next_tag = (tag_it != tags.end()) ? (int)(tag_it->offset - n0) : ninput;
 
-            // 1. 标签检测：如果看到新标签，重置计数器
-            while (tag_it != tags.end() && tag_it->offset == abs_offset_in) {
-                d_is_active = true;
-                d_count = d_frame_len;
-                
-                // 将起始标签转发到输出端
-                if (nproduced < noutput_items) {
-                    add_item_tag(0, nitems_written(0) + nproduced, d_tag_key,
-                                 tag_it->value, pmt::mp("frame_recover"));
-                }
-                tag_it++;
-            }
-
-            // 2. 数据处理
             if (d_is_active) {
-                if (nproduced < noutput_items) {
-                    out[nproduced++] = in[i];
-                    d_count--;
+                // 1. 激活窗口：复制到帧结束、下一个标签或输出缓存满为止
+                int n = std::min(d_count, next_tag - i);
+                n = std::min(n, noutput_items - nproduced);
+                if (out) {
+                    std::memcpy(out + nproduced, in + i, n * sizeof(gr_complex));
+                }
+                if (d_emit_pdu) {
+                    d_pdu_buf.insert(d_pdu_buf.end(), in + i, in + i + n);
+                }
+                nproduced += n;
+                d_count -= n;
+                i += n;
 
-                    if (d_count <= 0) {
-                        d_is_active = false; // 帧长达到，停止输出
+                if (d_count <= 0) {
+                    d_is_active = false; // 帧长达到，停止输出
+                    if (d_emit_pdu) {
+                        publish_pdu();
                     }
-                } else {
+                    continue;
+                }
+                if (i < next_tag) {
                     // 输出缓存已满，停止处理
                     consume_each(i);
                     return nproduced;
                 }
+            } else {
+                // 2. 非激活区：直接跳到下一个标签
+                i = next_tag;
+                if (i >= ninput) {
+                    break;
+                }
+            }
+
+            // 3. 标签检测：如果看到新标签，重置计数器
+            while (tag_it != tags.end() && tag_it->offset == n0 + i) {
+                d_is_active = true;
+                d_count = d_frame_len;
+
+                if (d_emit_pdu) {
+                    start_pdu(*tag_it, tags_corr);
+                }
+
+                // 将起始标签转发到输出端
+                if (out && nproduced < noutput_items) {
+                    add_item_tag(0, nitems_written(0) + nproduced, d_tag_key,
+                                 tag_it->value, pmt::mp("frame_recover"));
+                }
+                tag_it++;
             }
-            // 如果 d_is_active 为 false，则该输入样点被跳过（丢弃）
         }
 
         consume_each(ninput);
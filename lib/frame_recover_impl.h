@@ -9,6 +9,7 @@
 #define INCLUDED_FREQ_HOPPING_FRAME_RECOVER_IMPL_H
 
 #include <gnuradio/freq_hopping/frame_recover.h>
+#include <vector>
 
 namespace gr {
 namespace freq_hopping {
@@ -21,8 +22,18 @@ private:
     bool d_is_active;     // 是否处于输出激活状态
     pmt::pmt_t d_tag_key; // 缓存 phase_est 的 key
 
+    // PDU 输出
+    bool d_emit_pdu;
+    pmt::pmt_t d_corr_key;             // corr_est
+    pmt::pmt_t d_pdu_port;             // "pdus"
+    std::vector<gr_complex> d_pdu_buf; // 当前帧已收到的符号
+    pmt::pmt_t d_pdu_meta;             // 当前帧的元数据
+
+    void start_pdu(const tag_t& tag, const std::vector<tag_t>& tags_corr);
+    void publish_pdu();
+
 public:
-    frame_recover_impl(int frame_len);
+    frame_recover_impl(int frame_len, bool emit_pdu);
     ~frame_recover_impl();
 
     // Where all the action really happens
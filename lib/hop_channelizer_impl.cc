@@ -0,0 +1,222 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "hop_channelizer_impl.h"
+#include <gnuradio/io_signature.h>
+
+namespace gr {
+namespace freq_hopping {
+
+using input_type = gr_complex;
+using output_type = gr_complex;
+hop_channelizer::sptr hop_channelizer::make(double bw_hop,
+                                            double ch_sep,
+                                            double freq_carrier,
+                                            double fsa_hop,
+                                            double hop_rate,
+                                            int decim,
+                                            const std::vector<int>& seq_offsets,
+                                            uint64_t key)
+{
+    return gnuradio::make_block_sptr<hop_channelizer_impl>(
+        bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate, decim, seq_offsets, key);
+}
+
+// 接收端提前切换频率的时间（纳秒），与 hop_demod 相同
+static const uint64_t HOP_CHANNELIZER_EARLY_NS = 100000;
+
+/*
+ * The private constructor
+ */
+hop_channelizer_impl::hop_channelizer_impl(double bw_hop,
+                                           double ch_sep,
+                                           double freq_carrier,
+                                           double fsa_hop,
+                                           double hop_rate,
+                                           int decim,
+                                           const std::vector<int>& seq_offsets,
+                                           uint64_t key)
+    : gr::sync_decimator(
+          "hop_channelizer",
+          gr::io_signature::make(1, 1, sizeof(input_type)),
+          gr::io_signature::make(
+              seq_offsets.size(), seq_offsets.size(), sizeof(output_type)),
+          decim),
+      d_ch_sep(ch_sep),
+      d_fsa_hop(fsa_hop),
+      d_decim(decim),
+      d_seq_offsets(seq_offsets),
+      d_chan_cached(-1)
+{
+    // 参数验证（bw_hop、hop_rate 由 hop_plan 检查）
+    if (d_ch_sep <= 0) {
+        throw std::invalid_argument("ch_sep must be positive");
+    }
+    if (d_fsa_hop <= 0) {
+        throw std::invalid_argument("fsa_hop must be positive");
+    }
+    if (d_decim < 1) {
+        throw std::invalid_argument("decim must be at least 1");
+    }
+    if (d_fsa_hop / d_decim <= d_ch_sep) {
+        throw std::invalid_argument("fsa_hop/decim must be larger than ch_sep");
+    }
+    if (d_seq_offsets.empty()) {
+        throw std::invalid_argument("seq_offsets must not be empty");
+    }
+    // 时隙号从当天0点开始计，负偏移在0点之后会变成负的时隙号
+    for (int offset : d_seq_offsets) {
+        if (offset < 0) {
+            throw std::invalid_argument("seq_offsets must not be negative");
+        }
+    }
+
+    // 频率表和跳频序列（与发送端相同的 hop_plan）
+    d_plan = hop_plan::make(bw_hop, ch_sep, freq_carrier, hop_rate, key);
+    d_timing = std::make_unique<hop_timing>(d_plan, d_fsa_hop, d_decim);
+
+    // 信道化器：频率分辨率为信道间隔的 1/32，通带为半个信道间隔
+    int nfft_ch = fft_channelizer::choose_nfft_ch(d_fsa_hop, d_decim, d_ch_sep / 32);
+    double stopband = std::min(d_ch_sep, 0.5 * d_fsa_hop / d_decim);
+    d_chan = std::make_unique<fft_channelizer>(
+        d_fsa_hop, d_decim, nfft_ch, 0.5 * d_ch_sep, stopband);
+    d_chan_out.resize(d_chan->block_out());
+
+    // 50% 重叠：每次 work 的窗口前面需要半个 FFT 长度的历史数据
+    set_history(d_chan->fft_size() / 2 + 1);
+    set_output_multiple(d_chan->block_out());
+
+    std::cout << "Hop Channelizer initialized: " << d_plan->num_channels() << " channels, "
+              << d_seq_offsets.size() << " outputs, "
+              << "fft size: " << d_chan->fft_size() << ", "
+              << "output rate: " << d_fsa_hop / d_decim << " Hz" << std::endl;
+}
+
+/*
+ * Our virtual destructor.
+ */
+hop_channelizer_impl::~hop_channelizer_impl() {}
+
+uint64_t hop_channelizer_impl::tag_output(const tag_t& tag) const
+{
+    return (tag.offset + d_chan->delay() + d_decim - 1) / d_decim;
+}
+
+void hop_channelizer_impl::handle_rx_time(const tag_t& tag)
+{
+    // 解析rx_time标签
+    uint64_t sec = pmt::to_uint64(pmt::tuple_ref(tag.value, 0));
+    double frac_sec = pmt::to_double(pmt::tuple_ref(tag.value, 1));
+    uint64_t rx_time_ns = hop_plan::to_ns(sec, frac_sec);
+
+    // 输出样点 m 对应输入样点 m*decim - delay（delay 是 decim 的整数倍），
+    // 标签所在输入样点按输出时间轴换算为 offset + delay 再锚定。
+    // 与 hop_demod 相同，提前 0.1 ms 切换
+    bool first = !d_timing->anchored();
+    d_timing->anchor(tag.offset + d_chan->delay(), rx_time_ns, HOP_CHANNELIZER_EARLY_NS);
+
+    if (first) {
+        std::cout << "RX CHANNELIZER: FIRST HOP: slot_idx=" << d_timing->ref_slot()
+                  << ", offset=" << tag.offset
+                  << ", hop=" << d_timing->hop_of(d_timing->anchor_output()) << std::endl;
+    }
+}
+
+void hop_channelizer_impl::fill_port(
+    size_t port, gr_complex* out, uint64_t m0, int from, int to, uint64_t block_idx)
+{
+    // 没有时间参考时不知道当前信道，输出 0
+    if (!d_timing->anchored()) {
+        std::fill(out + from, out + to, gr_complex(0, 0));
+        return;
+    }
+
+    // 按跳频边界分段，每段从对应信道的输出中复制
+    int j = from;
+    while (j < to) {
+        uint64_t m = m0 + j;
+        uint64_t hop = d_timing->hop_of(m);
+        uint64_t m_next = d_timing->hop_start(hop + 1);
+        int nseg = static_cast<int>(
+            std::min<uint64_t>(m_next - m, static_cast<uint64_t>(to - j)));
+
+        uint64_t slot = d_timing->slot_of(m) + d_seq_offsets[port];
+        int ch = d_plan->channel(slot);
+        if (ch != d_chan_cached) {
+            d_chan->extract(d_plan->frequency(ch), block_idx, d_chan_out.data());
+            d_chan_cached = ch;
+        }
+
+        memcpy(out + j, d_chan_out.data() + j, nseg * sizeof(gr_complex));
+        j += nseg;
+    }
+}
+
+int hop_channelizer_impl::work(int noutput_items,
+                               gr_vector_const_void_star& input_items,
+                               gr_vector_void_star& output_items)
+{
+    auto in = static_cast<const input_type*>(input_items[0]);
+
+    const uint64_t nread = nitems_read(0);
+    const uint64_t nwritten = nitems_written(0);
+
+    // 新的rx_time标签先排队，输出到达标签对应的样点时才重新锚定，
+    // 之前的样点仍按原来的锚点取信道
+    std::vector<tag_t> tags;
+    get_tags_in_range(tags,
+                      0,
+                      nread,
+                      nread + static_cast<uint64_t>(noutput_items) * d_decim,
+                      pmt::string_to_symbol("rx_time"));
+    std::sort(tags.begin(), tags.end(), [](const tag_t& a, const tag_t& b) {
+        return a.offset < b.offset;
+    });
+    for (const auto& tag : tags) {
+        if (pmt::is_tuple(tag.value)) {
+            d_pending_tags.push_back(tag);
+        }
+    }
+
+    const int block_in = d_chan->block_in();
+    const int block_out = d_chan->block_out();
+    const int num_blocks = noutput_items / block_out;
+
+    for (int b = 0; b < num_blocks; ++b) {
+        // 整个跳频带宽只做一次 FFT
+        uint64_t block_idx = nread / block_in + b;
+        d_chan->execute(in + b * block_in);
+        d_chan_cached = -1;
+
+        // 块内按标签位置分段，每段用当时的锚点
+        uint64_t m0 = nwritten + static_cast<uint64_t>(b) * block_out;
+        int from = 0;
+        while (from < block_out) {
+            while (!d_pending_tags.empty() &&
+                   tag_output(d_pending_tags.front()) <= m0 + from) {
+                handle_rx_time(d_pending_tags.front());
+                d_pending_tags.pop_front();
+            }
+            int to = block_out;
+            if (!d_pending_tags.empty()) {
+                to = static_cast<int>(std::min<uint64_t>(
+                    tag_output(d_pending_tags.front()) - m0, block_out));
+            }
+
+            for (size_t port = 0; port < output_items.size(); ++port) {
+                auto out = static_cast<output_type*>(output_items[port]) + b * block_out;
+                fill_port(port, out, m0, from, to, block_idx);
+            }
+            from = to;
+        }
+    }
+
+    return num_blocks * block_out;
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
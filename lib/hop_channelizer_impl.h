@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_IMPL_H
+#define INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_IMPL_H
+
+#include <gnuradio/freq_hopping/hop_channelizer.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include "fft_channelizer.h"
+#include "hop_timing.h"
+#include <deque>
+#include <memory>
+
+namespace gr {
+namespace freq_hopping {
+
+class hop_channelizer_impl : public hop_channelizer
+{
+private:
+    // 参数
+    double d_ch_sep;
+    double d_fsa_hop;
+    int d_decim;
+    std::vector<int> d_seq_offsets;
+
+    // 频率表和跳频序列（与 hop_mod 共享同一个 hop_plan）
+    hop_plan::sptr d_plan;
+
+    // 信道化器
+    std::unique_ptr<fft_channelizer> d_chan;
+    std::vector<gr_complex> d_chan_out; // 当前块中最近一次取出的信道输出
+    int d_chan_cached;                  // d_chan_out 对应的信道号，-1 表示无效
+
+    // 按输出样点号精确计算的跳频边界（与 hop_demod 相同，锚定在最近的 rx_time 标签）
+    std::unique_ptr<hop_timing> d_timing;
+
+    // 已读到、但输出还没有到达其位置的 rx_time 标签（输出比输入晚 delay 个样点）
+    std::deque<tag_t> d_pending_tags;
+
+    // 标签所在输入样点对应的第一个输出样点
+    uint64_t tag_output(const tag_t& tag) const;
+    void handle_rx_time(const tag_t& tag);
+    // 从当前块的信道输出中取出端口 port 的输出样点 [from, to)，m0 为块的第一个输出样点
+    void fill_port(size_t port, gr_complex* out, uint64_t m0, int from, int to, uint64_t block_idx);
+
+public:
+    hop_channelizer_impl(double bw_hop,
+                         double ch_sep,
+                         double freq_carrier,
+                         double fsa_hop,
+                         double hop_rate,
+                         int decim,
+                         const std::vector<int>& seq_offsets,
+                         uint64_t key);
+    ~hop_channelizer_impl();
+
+    // Where all the action really happens
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_CHANNELIZER_IMPL_H */
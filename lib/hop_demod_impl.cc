@@ -7,124 +7,248 @@
 
 #include "hop_demod_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cmath>
 
 namespace gr {
 namespace freq_hopping {
 
 using input_type = gr_complex;
 using output_type = gr_complex;
-hop_demod::sptr hop_demod::make(
-    double bw_hop, double ch_sep, double freq_carrier, double fsa_hop, double hop_rate)
+hop_demod::sptr hop_demod::make(double bw_hop,
+                                double ch_sep,
+                                double freq_carrier,
+                                double fsa_hop,
+                                double hop_rate,
+                                bool use_phasor_table,
+                                int decim,
+                                bool simulated_time,
+                                bool emit_hop_tags,
+                                uint64_t key)
 {
-    return gnuradio::make_block_sptr<hop_demod_impl>(
-        bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate);
+    return gnuradio::make_block_sptr<hop_demod_impl>(bw_hop,
+                                                     ch_sep,
+                                                     freq_carrier,
+                                                     fsa_hop,
+                                                     hop_rate,
+                                                     use_phasor_table,
+                                                     decim,
+                                                     simulated_time,
+                                                     emit_hop_tags,
+                                                     key);
 }
 
+// 抽取时每块解跳的全速率样点数上限，块内数据留在缓存中
+static const int HOP_DEMOD_CHUNK_SAMPLES = 8192;
+// 接收端提前切换频率的时间（纳秒）
+static const uint64_t HOP_DEMOD_EARLY_NS = 100000;
+
 
 /*
  * The private constructor
  */
-hop_demod_impl::hop_demod_impl(
-    double bw_hop, double ch_sep, double freq_carrier, double fsa_hop, double hop_rate)
-    : gr::sync_block("hop_demod",
-                     gr::io_signature::make(1, 1, sizeof(input_type)),
-                     gr::io_signature::make(1, 1, sizeof(output_type))),
-      d_bw_hop(bw_hop),
-      d_ch_sep(ch_sep),
-      d_freq_carrier(freq_carrier),
+hop_demod_impl::hop_demod_impl(double bw_hop,
+                               double ch_sep,
+                               double freq_carrier,
+                               double fsa_hop,
+                               double hop_rate,
+                               bool use_phasor_table,
+                               int decim,
+                               bool simulated_time,
+                               bool emit_hop_tags,
+                               uint64_t key)
+    : gr::sync_decimator("hop_demod",
+                         gr::io_signature::make(1, 1, sizeof(input_type)),
+                         gr::io_signature::make(1, 1, sizeof(output_type)),
+                         decim),
       d_fsa_hop(fsa_hop),
-      d_hop_rate(hop_rate),
-      d_hop_period(1.0 / hop_rate),
-      d_samples_per_hop(d_hop_period * fsa_hop),
-      d_nco(nullptr),
-      d_has_time_reference(false),
-      d_ref_slot_idx(0),
+      d_decim(decim),
+      d_emit_hop_tags(emit_hop_tags),
+      d_hop_key(pmt::string_to_symbol("hop_start")),
+      d_last_slot_valid(false),
+      d_last_slot(0),
+      d_gap_key(pmt::string_to_symbol("dropped_hops")),
+      d_discontinuities(0),
+      d_lost_samples(0),
+      d_dropped_hops(0),
+      d_hop_valid(false),
       d_hop_count(0),
-      d_elapsed_samples(0),
       d_current_freq(0)
 {
-    // 参数验证
-    if (d_bw_hop <= 0) {
-        throw std::invalid_argument("bw_hop must be positive");
-    }
-    if (d_ch_sep <= 0) {
-        throw std::invalid_argument("ch_sep must be positive");
-    }
+    // 参数验证（bw_hop、ch_sep、hop_rate 由 hop_plan 检查）
     if (d_fsa_hop <= 0) {
         throw std::invalid_argument("fsa_hop must be positive");
     }
-    if (d_hop_rate <= 0) {
-        throw std::invalid_argument("hop_rate must be positive");
-    }else if (fabs(d_hop_rate - 110.0) < 1e-6){
-        d_hop_rate = 9600.0/87;
-        d_hop_period = 1.0 / d_hop_rate;
-        d_samples_per_hop = d_hop_period * fsa_hop;
+    if (d_decim < 1) {
+        throw std::invalid_argument("decim must be at least 1");
     }
 
-    // 初始化频率表（与发送端相同）
-    initialize_frequency_table();
+    // 频率表和跳频序列（与发送端相同的 hop_plan）
+    d_plan = hop_plan::make(bw_hop, ch_sep, freq_carrier, hop_rate, key);
+    d_timing = std::make_unique<hop_timing>(d_plan, d_fsa_hop, d_decim);
 
-    // 初始化跳频序列（与发送端相同）
-    initialize_hop_sequence();
+    // 预计算每个信道的下混频相位增量（旋转器只需要增量，不需要整张表）
+    if (use_phasor_table) {
+        d_phasor_table = d_plan->mixer_table(d_fsa_hop, -1, 0);
+    }
 
-    // 初始化随机数生成器（与发送端相同的种子）
-    d_rng = std::mt19937(42);
+    // 时间参考：USRP 的 rx_time；仿真时间下 hop_mod 的 tx_time 直接随样点流过来
+    d_time_keys.push_back(pmt::string_to_symbol("rx_time"));
+    if (simulated_time) {
+        d_time_keys.push_back(pmt::string_to_symbol("tx_time"));
+    }
 
-    // 创建NCO用于下混频
-    d_nco = nco_crcf_create(LIQUID_VCO);
+    // 解跳后直接多级抽取，不再输出全速率数据
+    if (d_decim > 1) {
+        d_decimator = std::make_unique<cascade_decimator>(d_decim);
+        d_chunk_len = std::max(1, HOP_DEMOD_CHUNK_SAMPLES / d_decim);
+        d_mixed.resize(d_chunk_len * d_decim);
+    }
 
-    std::cout << "Hop Demod initialized: " << d_num_ch << " channels, "
-              << "hop rate: " << d_hop_rate << " hops/s, "
+    std::cout << "Hop Demod initialized: " << d_plan->num_channels() << " channels, "
+              << "hop rate: " << d_plan->hop_rate() << " hops/s, "
               << "sample rate: " << d_fsa_hop << " Hz, "
-              << "samples per hop: " << d_samples_per_hop << std::endl;
+              << "decim: " << d_decim << ", "
+              << "output samples per hop: " << d_timing->samples_per_hop() << std::endl;
 }
 
 /*
  * Our virtual destructor.
  */
-hop_demod_impl::~hop_demod_impl()
+hop_demod_impl::~hop_demod_impl() {}
+
+void hop_demod_impl::update_hop_frequency()
 {
-    if (d_nco) {
-        nco_crcf_destroy(d_nco);
+    int freq_index = d_plan->channel(d_timing->ref_slot() + d_hop_count);
+    d_current_freq = d_plan->frequency(freq_index);
+
+    // 下混频：out = in * exp(-j*2*pi*f*n/fs)，相位在跳间保持连续
+    if (d_phasor_table) {
+        d_rotator.set_phase_incr(d_phasor_table->phase_incr(freq_index));
+    } else {
+        d_rotator.set_phase_incr(std::exp(
+            gr_complex(0, static_cast<float>(-2 * M_PI * d_current_freq / d_fsa_hop))));
     }
 }
 
-void hop_demod_impl::initialize_frequency_table()
+
+void hop_demod_impl::dehop(const gr_complex* in, gr_complex* out, int nout)
 {
-    // 计算信道数量（必须与发送端相同）
-    d_num_ch = static_cast<int>(std::floor(d_bw_hop / d_ch_sep));
-    if (d_num_ch < 1) {
-        d_num_ch = 1;
+    if (!d_decimator) {
+        d_rotator.rotateN(out, in, nout);
+        return;
     }
 
-    // 生成频率表（必须与发送端相同）
-    d_freq_vec.resize(d_num_ch);
-    for (int i = 0; i < d_num_ch; ++i) {
-        d_freq_vec[i] = (i - std::floor(d_num_ch / 2.0)) * d_ch_sep + d_freq_carrier;
+    // 按块下混频到缓存内的小缓冲，再抽取到输出
+    for (int i = 0; i < nout; i += d_chunk_len) {
+        int n = std::min(d_chunk_len, nout - i);
+        d_rotator.rotateN(d_mixed.data(), in + i * d_decim, n * d_decim);
+        d_decimator->execute(d_mixed.data(), n, out + i);
     }
 }
 
-void hop_demod_impl::initialize_hop_sequence()
+void hop_demod_impl::process(const gr_complex* in, gr_complex* out, int from, int to)
 {
-    // 生成跳频序列（必须与发送端相同）
-    int sequence_length = d_num_ch * 2;
-    d_hop_sequence.resize(sequence_length);
+    // 没有时间参考时直接复制（或抽取）数据
+    if (!d_timing->anchored()) {
+        if (d_decimator) {
+            d_decimator->execute(in + static_cast<size_t>(from) * d_decim, to - from, out + from);
+        } else {
+            memcpy(out + from, in + from, (to - from) * sizeof(gr_complex));
+        }
+        return;
+    }
 
-    // 使用相同的随机数生成器和分布
-    std::uniform_int_distribution<int> dist(0, d_num_ch - 1);
+    // 按跳频边界分段处理：边界由输出样点号直接算出，再整段下混频（并抽取）
+    uint64_t m = nitems_written(0) + from;
+    while (from < to) {
+        uint64_t hop = d_timing->hop_of(m);
+        if (!d_hop_valid || hop != d_hop_count) {
+            d_hop_count = hop;
+            d_hop_valid = true;
+            update_hop_frequency();
+
+            // 重新锚定后仍在同一时隙时不是边界
+            uint64_t slot = d_timing->ref_slot() + hop;
+            if (d_emit_hop_tags && d_last_slot_valid && slot != d_last_slot) {
+                pmt::pmt_t info = pmt::make_dict();
+                info = pmt::dict_add(info, pmt::mp("slot_idx"), pmt::from_uint64(slot));
+                info = pmt::dict_add(
+                    info, pmt::mp("channel"), pmt::from_long(d_plan->channel(slot)));
+                add_item_tag(0, m, d_hop_key, info);
+            }
+            d_last_slot = slot;
+            d_last_slot_valid = true;
+        }
 
-    for (int i = 0; i < sequence_length; ++i) {
-        d_hop_sequence[i] = dist(d_rng);
-    }
+        uint64_t next = d_timing->hop_start(hop + 1);
+        int nseg = static_cast<int>(std::min<uint64_t>(next - m, to - from));
 
-    // // 输出跳频序列用于调试
-    // std::cout << "Hop sequence: ";
-    // for (int i = 0; i < sequence_length; ++i) {
-    //     std::cout << d_hop_sequence[i] << " ";
-    // }
-    std::cout << std::endl;
+        dehop(in + static_cast<size_t>(from) * d_decim, out + from, nseg);
+        from += nseg;
+        m += nseg;
+    }
 }
 
+void hop_demod_impl::resync(const tag_t& tag, uint64_t tag_out)
+{
+    // 解析rx_time标签
+    uint64_t sec = pmt::to_uint64(pmt::tuple_ref(tag.value, 0));
+    double frac_sec = pmt::to_double(pmt::tuple_ref(tag.value, 1));
+    uint64_t time_ns = hop_plan::to_ns(sec, frac_sec);
+
+    // 按上一个锚点推算标签处应有的时刻和时隙
+    bool had_anchor = d_timing->anchored();
+    uint64_t expected_ns = 0;
+    uint64_t expected_slot = 0;
+    if (had_anchor) {
+        expected_ns = d_timing->expected_time_ns(tag.offset);
+        expected_slot = d_timing->slot_of(tag_out);
+    }
+
+    // 以标签所在样点锚定时隙，O(1)。提前0.1 ms切换频率，提前量不能超过频率切换时间
+    d_timing->anchor(tag.offset, time_ns, HOP_DEMOD_EARLY_NS);
+    d_hop_valid = false;
+
+    if (!had_anchor) {
+        std::cout << "RX: FIRST HOP: slot_idx=" << d_timing->ref_slot()
+                  << ", offset=" << tag.offset
+                  << ", hop=" << d_timing->hop_of(d_timing->anchor_output()) << std::endl;
+        return;
+    }
+
+    // 时间标签有纳秒截断误差，相差不到半个样点视为连续
+    int64_t diff_ns = static_cast<int64_t>(time_ns - expected_ns);
+    double diff_samples = diff_ns * d_fsa_hop / 1e9;
+    if (std::fabs(diff_samples) < 0.5) {
+        return;
+    }
+    d_discontinuities++;
+    // 丢样点之后的第一个跳不完整，不作为边界
+    d_last_slot_valid = false;
+
+    if (diff_ns < 0) {
+        // 设备时间被重设到更早的时刻，没有丢样点，只重新锚定
+        return;
+    }
+
+    uint64_t lost = static_cast<uint64_t>(std::llround(diff_samples));
+    uint64_t slot = d_timing->slot_of(tag_out);
+    uint64_t dropped = slot > expected_slot ? slot - expected_slot : 0;
+    d_lost_samples += lost;
+    d_dropped_hops += dropped;
+
+    // 抽取滤波器里是丢失之前的样点，清空后从新时隙重新开始
+    if (d_decimator) {
+        d_decimator->reset();
+    }
+
+    pmt::pmt_t info = pmt::make_dict();
+    info = pmt::dict_add(info, pmt::mp("lost_samples"), pmt::from_uint64(lost));
+    info = pmt::dict_add(info, pmt::mp("dropped_hops"), pmt::from_uint64(dropped));
+    info = pmt::dict_add(info, pmt::mp("slot_idx"), pmt::from_uint64(slot));
+    add_item_tag(0, tag_out, d_gap_key, info);
+}
 
 int hop_demod_impl::work(int noutput_items,
                          gr_vector_const_void_star& input_items,
@@ -134,84 +258,42 @@ int hop_demod_impl::work(int noutput_items,
     auto out = static_cast<output_type*>(output_items[0]);
 
     const uint64_t nitems_passed = nitems_read(0);
+    const uint64_t nwritten = nitems_written(0);
 
-    // 检查rx_time标签
+    // 检查rx_time标签（仿真时间下还有tx_time），按位置排序
     std::vector<tag_t> tags;
-    get_tags_in_range(tags, 0, nitems_passed, nitems_passed + noutput_items, pmt::string_to_symbol("rx_time"));
-
-    for (const auto& tag : tags) {
-        if (pmt::is_tuple(tag.value)) {
-            // 解析rx_time标签
-            uint64_t sec = pmt::to_uint64(pmt::tuple_ref(tag.value, 0));
-            double frac_sec = pmt::to_double(pmt::tuple_ref(tag.value, 1));
-
-            // 计算距离当天0点的纳秒数
-            const uint64_t nanoseconds_per_day = 24 * 3600 * 1000000000ULL;
-            uint64_t rx_time_ns_since_midnight = (sec % (24 * 3600)) * 1000000000ULL +
-                                                static_cast<uint64_t>(frac_sec * 1e9);
-
-            // 计算时隙大小（纳秒）
-            uint64_t slot_size_ns = static_cast<uint64_t>(d_hop_period * 1e9);
-
-            // 计算当前slot索引
-            d_ref_slot_idx = rx_time_ns_since_midnight / slot_size_ns;
-
-            // 计算当前slot的起始纳秒值
-            uint64_t ref_slot_ns = d_ref_slot_idx * slot_size_ns;
-
-            // 初始化状态
-            d_hop_count = 0;
-            d_elapsed_samples = (rx_time_ns_since_midnight - ref_slot_ns) * d_fsa_hop / 1e9;
-            // 这里将d_elapsed_samples稍微增大一点，可以让接收端提前切换频率。增大长度不能超过频率切换时间
-            d_elapsed_samples = d_elapsed_samples + 0.1*d_fsa_hop/1e3;
-            d_has_time_reference = true;
-
-            // 计算初始频率
-            unsigned hop_seq_idx = (d_ref_slot_idx + d_hop_count) % d_hop_sequence.size();
-            int freq_index = d_hop_sequence[hop_seq_idx];
-            d_current_freq = d_freq_vec[freq_index];
-            nco_crcf_set_frequency(d_nco, -2 * M_PI * d_current_freq / d_fsa_hop);
-
-            std::cout << "RX: FIRST HOP: ref_slot_ns=" << ref_slot_ns
-                      << ", seq_idx=" << hop_seq_idx
-                      << ", elapsed_samples=" << d_elapsed_samples << std::endl;
-        }
+    for (const auto& key : d_time_keys) {
+        std::vector<tag_t> key_tags;
+        get_tags_in_range(key_tags,
+                          0,
+                          nitems_passed,
+                          nitems_passed + static_cast<uint64_t>(noutput_items) * d_decim,
+                          key);
+        tags.insert(tags.end(), key_tags.begin(), key_tags.end());
     }
-
-    // 如果没有时间参考，直接复制数据
-    if (!d_has_time_reference) {
-        memcpy(out, in, noutput_items * sizeof(gr_complex));
-        return noutput_items;
+    if (d_time_keys.size() > 1) {
+        std::stable_sort(tags.begin(), tags.end(), [](const tag_t& a, const tag_t& b) {
+            return a.offset < b.offset;
+        });
     }
 
-    // 逐个样本处理
-    for (int i = 0; i < noutput_items; ++i) {
-        // 检查是否需要切换频率
-        if (d_elapsed_samples >= d_samples_per_hop) {
-            d_elapsed_samples -= d_samples_per_hop;
-            d_hop_count++;
-
-            // 计算新的频率索引
-            unsigned hop_seq_idx = (d_ref_slot_idx + d_hop_count) % d_hop_sequence.size();
-            int freq_index = d_hop_sequence[hop_seq_idx];
-            d_current_freq = d_freq_vec[freq_index];
-            nco_crcf_set_frequency(d_nco, 2 * M_PI * d_current_freq / d_fsa_hop);
-
-            // //输出调试信息（可选，频率切换时输出）
-            // std::cout << "Rx: Hop changed: hop_seq_idx=" << hop_seq_idx
-            //           << ", freq=" << d_current_freq << " Hz" << std::endl;
+    int idx = 0;
+    for (const auto& tag : tags) {
+        if (!pmt::is_tuple(tag.value)) {
+            continue;
         }
 
-        // 下混频当前样本
-        gr_complex sample;
-        nco_crcf_step(d_nco);
-        nco_crcf_mix_down(d_nco, in[i], &sample);
-        out[i] = sample;
+        // 标签之前的样点仍按原来的时间参考处理
+        uint64_t tag_out = (tag.offset + d_decim - 1) / d_decim;
+        int pos = static_cast<int>(std::min<uint64_t>(tag_out - nwritten, noutput_items));
+        process(in, out, idx, pos);
+        idx = pos;
 
-        // 更新已处理样本数
-        d_elapsed_samples += 1.0;
+        resync(tag, tag_out);
     }
 
+    process(in, out, idx, noutput_items);
+
     return noutput_items;
 }
 
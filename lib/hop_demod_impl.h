@@ -8,9 +8,14 @@
 #ifndef INCLUDED_FREQ_HOPPING_HOP_DEMOD_IMPL_H
 #define INCLUDED_FREQ_HOPPING_HOP_DEMOD_IMPL_H
 
+#include <gnuradio/blocks/rotator.h>
 #include <gnuradio/freq_hopping/hop_demod.h>
-#include <liquid/liquid.h>
-#include <random>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include "cascade_resampler.h"
+#include "hop_timing.h"
+#include "phasor_table.h"
+#include <atomic>
+#include <memory>
 
 namespace gr {
 namespace freq_hopping {
@@ -19,42 +24,74 @@ class hop_demod_impl : public hop_demod
 {
 private:
     // 参数
-    double d_bw_hop;
-    double d_ch_sep;
-    double d_freq_carrier;
     double d_fsa_hop;
-    double d_hop_rate;
-    double d_hop_period;
-    double d_samples_per_hop;
+    int d_decim;
 
-    // 频率表和跳频序列
-    std::vector<double> d_freq_vec;
-    std::vector<int> d_hop_sequence;
-    int d_num_ch;
+    // 跳频方案：频率表、跳频图案和时隙换算（与发送端共享）
+    hop_plan::sptr d_plan;
 
-    // NCO和随机数生成器
-    nco_crcf d_nco;
-    std::mt19937 d_rng;
+    // 按输出样点号精确计算的跳频边界（锚定在最近的时间标签）
+    std::unique_ptr<hop_timing> d_timing;
+
+    // 下混频旋转器（VOLK）
+    gr::blocks::rotator d_rotator;
+
+    // 预计算的信道相位增量（use_phasor_table 时有效）
+    std::shared_ptr<const phasor_table> d_phasor_table;
+
+    // 多级抽取器（decim > 1 时有效）和解跳后的全速率小块缓冲
+    std::unique_ptr<cascade_decimator> d_decimator;
+    int d_chunk_len;                 // 每块输出样点数
+    std::vector<gr_complex> d_mixed; // d_chunk_len * d_decim
+
+    // 时间参考标签：rx_time，仿真时间模式下还有 tx_time
+    std::vector<pmt::pmt_t> d_time_keys;
+
+    // 跳频边界标签
+    bool d_emit_hop_tags;
+    pmt::pmt_t d_hop_key;
+    bool d_last_slot_valid; // d_last_slot 是紧接在当前位置之前的样点所在的时隙
+    uint64_t d_last_slot;
+
+    // 时间不连续（USRP 溢出）统计和标记
+    pmt::pmt_t d_gap_key;
+    std::atomic<uint64_t> d_discontinuities;
+    std::atomic<uint64_t> d_lost_samples;
+    std::atomic<uint64_t> d_dropped_hops;
 
     // 状态变量
-    bool d_has_time_reference;
-    uint64_t d_ref_slot_idx;
-    uint64_t d_hop_count;
-    double d_elapsed_samples;
+    bool d_hop_valid;     // d_hop_count 对应的频率已设置
+    uint64_t d_hop_count; // 相对锚点时隙的跳数
     double d_current_freq;
 
     // 内部方法
-    void initialize_frequency_table();
-    void initialize_hop_sequence();
+    // 根据锚点时隙 + d_hop_count 更新当前频率和旋转器相位增量
+    void update_hop_frequency();
+    // 下混频并抽取，产生 nout 个输出样点
+    void dehop(const gr_complex* in, gr_complex* out, int nout);
+    // 处理输出样点 [from, to)，in/out 指向本次 work 的缓冲区起点
+    void process(const gr_complex* in, gr_complex* out, int from, int to);
+    // 以时间标签重新锚定；与上一个锚点推算的时刻不连续时打标签并计数，
+    // tag_out 为标签之后的第一个输出样点
+    void resync(const tag_t& tag, uint64_t tag_out);
 
 public:
     hop_demod_impl(double bw_hop,
                    double ch_sep,
                    double freq_carrier,
                    double fsa_hop,
-                   double hop_rate);
+                   double hop_rate,
+                   bool use_phasor_table,
+                   int decim,
+                   bool simulated_time,
+                   bool emit_hop_tags,
+                   uint64_t key);
     ~hop_demod_impl();
 
+    uint64_t discontinuities() const override { return d_discontinuities.load(); }
+    uint64_t lost_samples() const override { return d_lost_samples.load(); }
+    uint64_t dropped_hops() const override { return d_dropped_hops.load(); }
+
     // Where all the action really happens
     int work(int noutput_items,
              gr_vector_const_void_star& input_items,
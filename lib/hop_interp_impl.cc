@@ -29,20 +29,14 @@ hop_interp_impl::hop_interp_impl(int interp_fac,int vlen_in)
                      gr::io_signature::make(1, 1, sizeof(output_type)*vlen_in*interp_fac)),
 d_interp_fac(interp_fac),
 d_vlen_in(vlen_in),
-resampler(nullptr)
+d_interpolator(interp_fac)
 {
-    resampler = rresamp_crcf_create_default(d_interp_fac, 1);
 }
 
 /*
  * Our virtual destructor.
  */
-hop_interp_impl::~hop_interp_impl()
-{
-    if (resampler) {
-        rresamp_crcf_destroy(resampler);
-    }
-}
+hop_interp_impl::~hop_interp_impl() {}
 
 int hop_interp_impl::work(int noutput_items,
                           gr_vector_const_void_star& input_items,
@@ -51,24 +45,14 @@ int hop_interp_impl::work(int noutput_items,
     auto in = static_cast<const input_type*>(input_items[0]);
     auto out = static_cast<output_type*>(output_items[0]);
 
-    if (resampler == nullptr) {
-        return 0;
-    }
-
-    // 这是rrsample的bug，由于使用了pfb会小，乘以sqrt(P)补回来
-    gr_complex scale = gr_complex(std::sqrt(d_interp_fac),0);
-
-    // Do <+signal processing+>
+    // 每个向量（一跳）整块插值，跳与跳之间清空滤波器状态
     int idx_item = 0;
     for (; idx_item < noutput_items; ++idx_item) {
-        auto frame_in = const_cast<input_type*>(in + idx_item * d_vlen_in);
+        auto frame_in = in + idx_item * d_vlen_in;
         auto frame_out = out + idx_item * d_vlen_in * d_interp_fac;
 
-        for (int i=0; i<d_vlen_in; i++) {
-            auto val_in = *(frame_in+i) * scale;
-            rresamp_crcf_execute(resampler, &val_in, frame_out+i*d_interp_fac);
-        }
-        rresamp_crcf_reset(resampler);
+        d_interpolator.execute(frame_in, d_vlen_in, frame_out);
+        d_interpolator.reset();
     }
 
 
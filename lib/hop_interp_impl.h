@@ -9,7 +9,7 @@
 #define INCLUDED_FREQ_HOPPING_HOP_INTERP_IMPL_H
 
 #include <gnuradio/freq_hopping/hop_interp.h>
-#include "liquid/liquid.h"
+#include "cascade_resampler.h"
 
 namespace gr {
 namespace freq_hopping {
@@ -19,7 +19,7 @@ class hop_interp_impl : public hop_interp
 private:
     int d_interp_fac;
     int d_vlen_in;
-    rresamp_crcf resampler ;
+    cascade_interpolator d_interpolator;
 
 public:
     hop_interp_impl(int interp_fac, int vlen_in = 1);
@@ -10,70 +10,104 @@
 // #include <gnuradio/uhd/usrp/multi_usrp.hpp>
 
 const std::string TX_TIME_TAG_KEY = "tx_time";
+const pmt::pmt_t TIME_PORT = pmt::mp("time");
 
 namespace gr {
 namespace freq_hopping {
 
 using input_type = gr_complex;
 using output_type = gr_complex;
-hop_mod::sptr hop_mod::make(double bw_hop, double ch_sep, double freq_carrier, double fsa_hop, double hop_rate, int vlen)
+hop_mod::sptr hop_mod::make(double bw_hop,
+                            double ch_sep,
+                            double freq_carrier,
+                            double fsa_hop,
+                            double hop_rate,
+                            int vlen,
+                            bool use_phasor_table,
+                            int clock,
+                            double lead_time,
+                            double epoch,
+                            uint64_t key)
 {
-    return gnuradio::make_block_sptr<hop_mod_impl>(bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate, vlen);
+    return gnuradio::make_block_sptr<hop_mod_impl>(bw_hop,
+                                                   ch_sep,
+                                                   freq_carrier,
+                                                   fsa_hop,
+                                                   hop_rate,
+                                                   vlen,
+                                                   use_phasor_table,
+                                                   clock,
+                                                   lead_time,
+                                                   epoch,
+                                                   key);
 }
 
+// 相量表每信道的最大长度（样点），333 个信道约占 5 MB
+static const int PHASOR_TABLE_MAX_LEN = 2048;
+
 
 /*
  * The private constructor
  */
-hop_mod_impl::hop_mod_impl(double bw_hop, double ch_sep, double freq_carrier, double fsa_hop, double hop_rate, int vlen)
+hop_mod_impl::hop_mod_impl(double bw_hop,
+                           double ch_sep,
+                           double freq_carrier,
+                           double fsa_hop,
+                           double hop_rate,
+                           int vlen,
+                           bool use_phasor_table,
+                           int clock,
+                           double lead_time,
+                           double epoch,
+                           uint64_t key)
     : gr::sync_block("hop_mod",
                      gr::io_signature::make(1, 1, vlen*sizeof(input_type)),
                      gr::io_signature::make(1, 1, vlen*sizeof(output_type))),
-    d_bw_hop(bw_hop),
-    d_ch_sep(ch_sep),
-    d_freq_carrier(freq_carrier),
     d_fsa_hop(fsa_hop),
-    d_hop_rate(hop_rate),
     d_vlen(vlen),
-    d_hop_period(1.0/d_hop_rate),
     d_hop_count(0),
     d_first_hop(true),
     d_start_time(0),
+    d_lead_ns(0),
+    d_simulated(false),
+    d_start_item(0),
     d_nco(nullptr)
 {
-    // 参数验证
-    if (d_bw_hop <= 0) {
-        throw std::invalid_argument("bw_hop must be positive");
-    }
-    if (d_ch_sep <= 0) {
-        throw std::invalid_argument("ch_sep must be positive");
-    }
+    // 参数验证（bw_hop、ch_sep、hop_rate 由 hop_plan 检查）
     if (d_fsa_hop <= 0) {
         throw std::invalid_argument("fsa_hop must be positive");
     }
     if (d_vlen <= 0) {
         throw std::invalid_argument("vlen must be positive");
     }
-    if (d_hop_rate <= 0) {
-        throw std::invalid_argument("hop_rate must be positive");
-    }else if (fabs(d_hop_rate - 110.0) < 1e-6){
-        d_hop_rate = 9600.0/87;
-        d_hop_period = 1.0 / d_hop_rate;
-        // d_samples_per_hop = d_hop_period * fsa_hop;
+    if (clock < time_source::HOST || clock > time_source::SIMULATED) {
+        throw std::invalid_argument("clock must be 0 (host), 1 (device) or 2 (simulated)");
     }
+    if (lead_time < 0) {
+        throw std::invalid_argument("lead_time must not be negative");
+    }
+    if (epoch < 0) {
+        throw std::invalid_argument("epoch must not be negative");
+    }
+    d_time_source = time_source::make(static_cast<time_source::source_type>(clock),
+                                      static_cast<uint64_t>(epoch * 1e9));
+    d_simulated = d_time_source->type() == time_source::SIMULATED;
+    d_lead_ns = static_cast<uint64_t>(lead_time * 1e9);
 
-    // 初始化频率表
-    initialize_frequency_table();
-
-
-    // 初始化跳频序列
-    initialize_hop_sequence();
+    // 频率表和跳频序列：相同参数的块共享同一个 hop_plan
+    d_plan = hop_plan::make(bw_hop, ch_sep, freq_carrier, hop_rate, key);
 
-    // 初始化随机数生成器
-    // std::random_device rd;
-    d_rng = std::mt19937(42);
     d_nco = nco_crcf_create(LIQUID_VCO);
 
+    // 预计算每个信道的上混频相量表（同一 hop_plan 下相同采样率和长度的表只算一次）
+    if (use_phasor_table) {
+        d_phasor_table =
+            d_plan->mixer_table(d_fsa_hop, 1, std::min(d_vlen, PHASOR_TABLE_MAX_LEN));
+    }
+
+    // 设备时间：(整数秒, 小数秒) 元组，或含 rx_time/time 键的字典
+    message_port_register_in(TIME_PORT);
+    set_msg_handler(TIME_PORT, [this](const pmt::pmt_t& msg) { handle_time_msg(msg); });
 
     d_initialized = true;
 }
@@ -88,86 +122,72 @@ hop_mod_impl::~hop_mod_impl()
     }
 }
 
-void hop_mod_impl::initialize_frequency_table()
+int hop_mod_impl::get_channel_by_hop_count()
 {
-    // 计算信道数量
-    d_num_ch = static_cast<int>(std::floor(d_bw_hop / d_ch_sep));
-    if (d_num_ch < 1) {
-        d_num_ch = 1;
-    }
-
-    // 生成频率表
-    d_freq_vec.resize(d_num_ch);
-    for (int i = 0; i < d_num_ch; ++i) {
-        d_freq_vec[i] = (i - std::floor(d_num_ch / 2.0)) * d_ch_sep + d_freq_carrier;
-    }
-
+    // 基于跳频计数器计算信道号
+    return d_plan->channel(d_hop_count);
 }
 
-void hop_mod_impl::initialize_hop_sequence()
+double hop_mod_impl::get_frequency_by_hop_count()
 {
-    // 生成跳频序列 - 长度为 num_channels * 2 的随机序列
-    int sequence_length = d_num_ch * 2;
-    d_hop_sequence.resize(sequence_length);
-
-    // 使用均匀分布生成随机索引
-    std::uniform_int_distribution<int> dist(0, d_num_ch - 1);
-
-    for (int i = 0; i < sequence_length; ++i) {
-        d_hop_sequence[i] = dist(d_rng);
-    }
+    // 基于跳频计数器计算频率
+    return d_plan->frequency(get_channel_by_hop_count());
 }
 
-double hop_mod_impl::get_frequency_by_hop_count()
+void hop_mod_impl::set_time_source(time_source::sptr source)
 {
-    // 基于跳频计数器计算频率
-    int freq_index = d_hop_sequence[d_hop_count % d_hop_sequence.size()];
-    return d_freq_vec[freq_index];
+    if (!source) {
+        throw std::invalid_argument("time source must not be null");
+    }
+    // 仿真时间与否跟随新时钟，而不是构造时的 clock 参数
+    d_time_source = source;
+    d_simulated = source->type() == time_source::SIMULATED;
 }
 
-std::pair<uint64_t, double> hop_mod_impl::get_current_usrp_time()
+void hop_mod_impl::handle_time_msg(const pmt::pmt_t& msg)
 {
-    // 获取当前时间（模拟 USRP 时间）
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch(); // ns
+    pmt::pmt_t time = msg;
+    if (pmt::is_dict(msg)) {
+        time = pmt::dict_ref(msg, pmt::mp("rx_time"), pmt::PMT_NIL);
+        if (pmt::is_null(time)) {
+            time = pmt::dict_ref(msg, TIME_PORT, pmt::PMT_NIL);
+        }
+    }
+    if (!pmt::is_tuple(time) || pmt::length(time) < 2) {
+        std::cerr << "Warning: hop_mod time message must be a (sec, frac_sec) tuple"
+                  << std::endl;
+        return;
+    }
 
-    // 转换为秒
-    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
-    auto fractional = duration - seconds;
-    double fractional_seconds = std::chrono::duration<double>(fractional).count();
+    uint64_t sec = pmt::to_uint64(pmt::tuple_ref(time, 0));
+    double frac_sec = pmt::to_double(pmt::tuple_ref(time, 1));
+    d_time_source->set_time(hop_plan::to_ns(sec, frac_sec));
+}
 
-    return std::make_pair(seconds.count(), fractional_seconds);
+uint64_t hop_mod_impl::virtual_time_ns(uint64_t item) const
+{
+    double elapsed = static_cast<double>(item - d_start_item) * d_vlen / d_fsa_hop;
+    return d_start_time + static_cast<uint64_t>(elapsed * 1e9);
 }
 
 uint64_t hop_mod_impl::align_to_time_slot(uint64_t current_time_ns)
 {
-    // 计算从当天0点开始的纳秒数
-    const uint64_t nanoseconds_per_day = 24 * 3600 * 1000000000ULL;
-    uint64_t time_since_midnight = current_time_ns % nanoseconds_per_day;
-
-    // 计算时隙大小（纳秒）
-    uint64_t slot_size_ns = static_cast<uint64_t>(d_hop_period * 1e9);
-
-    // 当前slot的结尾时刻的编号，即下一slot的开始时刻的编号
-    uint64_t current_slot_end_idx = (time_since_midnight+slot_size_ns) / slot_size_ns;
-
-    // 真实发送时刻的编号，在current_slot_end基础上+1,是为了至少留1个slot处理
-    uint64_t real_tx_slot_idx = current_slot_end_idx + 1;
+    // 真实发送时刻的编号：下一slot的开始时刻编号再+1，至少留1个slot处理，
+    // 再额外提前 lead_time。仿真时间没有处理延迟，直接取下一个时隙边界
+    uint64_t real_tx_slot_idx =
+        d_simulated ? d_plan->slot_at_or_after(current_time_ns + d_lead_ns)
+                    : d_plan->first_tx_slot(current_time_ns + d_lead_ns);
 
     // 这一段很重要！需要按照真实发送时刻的编号来初始化d_hop_count
     // 后续依次走。这样接收端就能知道任意时刻的freq_tab
-    d_hop_count = real_tx_slot_idx % (d_hop_sequence.size());
+    d_hop_count = real_tx_slot_idx;
     std::cout << "TX: FIRST HOP: idx: " << d_hop_count << std::endl;
 
-    // 下一个时隙的开始时间（从当天0点开始）
-    uint64_t real_tx_start = real_tx_slot_idx * slot_size_ns;
+    // 计算绝对时间（从epoch开始），按跳速的分数精确换算
+    uint64_t real_tx_start =
+        d_plan->slot_start_ns(current_time_ns + d_lead_ns, real_tx_slot_idx);
     std::cout << "TX: FIRST HOP: real_tx_start: " << real_tx_start << std::endl;
-
-    // 计算绝对时间（从epoch开始）
-    uint64_t base_time = current_time_ns - time_since_midnight; // today 0:0:0
-    uint64_t aligned_time = base_time + real_tx_start;
-
-    return aligned_time;
+    return real_tx_start;
 }
 
 
@@ -180,13 +200,15 @@ int hop_mod_impl::work(int noutput_items,
 
     // 如果是第一跳，初始化起始时间
     if (d_first_hop) {
-        // 获取当前 USRP 时间（纳秒）
-        auto current_time = get_current_usrp_time();
-        uint64_t current_time_ns = current_time.first * 1000000000ULL +
-                                  static_cast<uint64_t>(current_time.second * 1e9);
+        // 设备时钟尚未给出时间时不输出，等待 time 消息
+        if (!d_time_source->valid()) {
+            return 0;
+        }
 
-        // 对齐到下一个时隙开始
+        // 获取当前时间（纳秒），对齐到下一个时隙开始
+        uint64_t current_time_ns = d_time_source->now_ns();
         d_start_time = align_to_time_slot(current_time_ns);
+        d_start_item = nitems_written(0);
 
         d_first_hop = false;
         // std::cout << "current_time_ns: " << current_time_ns << std::endl;
@@ -220,19 +242,29 @@ int hop_mod_impl::work(int noutput_items,
         const input_type* frame_in = in + idx_vec * d_vlen;
         output_type* frame_out = out + idx_vec * d_vlen;
 
-        // 为当前帧选择频率
-        double freq_tb = get_frequency_by_hop_count();
-        // 设置 NCO 频率
-        nco_crcf_set_phase(d_nco, 0);
-        nco_crcf_set_frequency(d_nco, 2 * M_PI * freq_tb / d_fsa_hop);
+        if (d_phasor_table) {
+            // 查表上混频，每帧从零相位开始
+            d_phasor_table->mix(get_channel_by_hop_count(), frame_in, frame_out, d_vlen);
+        } else {
+            // 为当前帧选择频率
+            double freq_tb = get_frequency_by_hop_count();
+            // 设置 NCO 频率
+            nco_crcf_set_phase(d_nco, 0);
+            nco_crcf_set_frequency(d_nco, 2 * M_PI * freq_tb / d_fsa_hop);
 
-        // 使用 NCO 进行频率调制（上混频）
-        nco_crcf_mix_block_up(d_nco, const_cast<input_type*>(frame_in), frame_out, d_vlen);
+            // 使用 NCO 进行频率调制（上混频）
+            nco_crcf_mix_block_up(d_nco, const_cast<input_type*>(frame_in), frame_out, d_vlen);
+        }
 
         // 增加跳频计数器
         d_hop_count++;
     }
 
+    // 仿真时间：时钟推进到本次输出结束的时刻，与共享该时钟的其他块保持一致
+    if (d_simulated) {
+        d_time_source->set_time(virtual_time_ns(nitems_written(0) + idx_vec));
+    }
+
     // Tell runtime system how many output items we produced.
     return idx_vec;
 }
@@ -9,11 +9,13 @@
 #define INCLUDED_FREQ_HOPPING_HOP_MOD_IMPL_H
 
 #include <gnuradio/freq_hopping/hop_mod.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
 
 #include <liquid/liquid.h>
 
+#include "phasor_table.h"
 
-#include <random>
+#include <memory>
 
 namespace gr {
 namespace freq_hopping {
@@ -21,25 +23,24 @@ namespace freq_hopping {
 class hop_mod_impl : public hop_mod
 {
 private:
-    double d_bw_hop;        // 跳频带宽
-    double d_ch_sep;        // 信道间隔
-    double d_freq_carrier;  // 载波中心频率
     double d_fsa_hop;       // 跳频采样率
-    double d_hop_rate;
     int d_vlen;
 
-    int d_num_ch;           // 信道数量
-    std::vector<double> d_freq_vec;  // 频率表
+    // 跳频方案：频率表、跳频图案和时隙换算（与接收端共享）
+    hop_plan::sptr d_plan;
 
     // 跳频参数
-    double d_hop_period;    // 跳频周期（秒）
     uint64_t d_hop_count;   // 跳频计数器
     bool d_first_hop;       // 是否是第一跳
     uint64_t d_start_time;  // 起始时间
 
-    // 随机数生成器
-    std::mt19937 d_rng;
-    std::vector<int> d_hop_sequence;  // 跳频序列
+    // 第一跳对齐所用的时钟和额外提前量（纳秒）
+    time_source::sptr d_time_source;
+    uint64_t d_lead_ns;
+
+    // 仿真时间：时钟随输出样点推进，d_start_item 为第一跳的输出向量号
+    bool d_simulated;
+    uint64_t d_start_item;
 
     // 帧长度
     int d_frame_len;
@@ -48,20 +49,35 @@ private:
     // NCO对象
     nco_crcf d_nco;
 
+    // 预计算的信道相量表（use_phasor_table 时有效）
+    std::shared_ptr<const phasor_table> d_phasor_table;
+
     // 私有方法
-    void initialize_frequency_table();
-    void initialize_hop_sequence();
+    int get_channel_by_hop_count();
     double get_frequency_by_hop_count();
-    // uint64_t get_current_usrp_time();
-    std::pair<uint64_t, double> get_current_usrp_time();
     uint64_t align_to_time_slot(uint64_t current_time_ns);
+    void handle_time_msg(const pmt::pmt_t& msg);
+    // 仿真时间下第 item 个输出向量的时刻（纳秒）
+    uint64_t virtual_time_ns(uint64_t item) const;
     // double get_random_frequency();
     // std::vector<gr_complex> frequency_modulate(const std::vector<gr_complex>& input, double freq);
 
 public:
-    hop_mod_impl(double bw_hop, double ch_sep, double freq_carrier, double fsa_hop, double hop_rate, int vlen);
+    hop_mod_impl(double bw_hop,
+                 double ch_sep,
+                 double freq_carrier,
+                 double fsa_hop,
+                 double hop_rate,
+                 int vlen,
+                 bool use_phasor_table,
+                 int clock,
+                 double lead_time,
+                 double epoch,
+                 uint64_t key);
     ~hop_mod_impl();
 
+    void set_time_source(time_source::sptr source) override;
+
     // Where all the action really happens
     int work(int noutput_items,
              gr_vector_const_void_star& input_items,
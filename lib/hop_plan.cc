@@ -0,0 +1,148 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include "hop_sequence.h"
+#include "hop_timing.h"
+#include "phasor_table.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+// 已创建的跳频方案，按参数索引；只保存弱引用，最后一个使用者释放后自动失效
+typedef std::tuple<double, double, double, double, uint64_t> plan_key;
+std::mutex s_registry_mutex;
+std::map<plan_key, std::weak_ptr<hop_plan>> s_registry;
+
+// 时隙换算的中间结果：纳秒乘以跳速分子会超过 64 位
+typedef unsigned __int128 u128;
+const uint64_t NS_PER_SEC = 1000000000ULL;
+// 跳速分母的上限
+const uint64_t RATE_MAX_DEN = 1000000;
+} // namespace
+
+hop_plan::sptr hop_plan::make(
+    double bw_hop, double ch_sep, double freq_carrier, double hop_rate, uint64_t key)
+{
+    // 参数验证
+    if (bw_hop <= 0) {
+        throw std::invalid_argument("bw_hop must be positive");
+    }
+    if (ch_sep <= 0) {
+        throw std::invalid_argument("ch_sep must be positive");
+    }
+    if (hop_rate <= 0) {
+        throw std::invalid_argument("hop_rate must be positive");
+    } else if (std::fabs(hop_rate - 110.0) < 1e-6) {
+        // 110 跳/秒实际为 9600/87，与帧长计算一致
+        hop_rate = 9600.0 / 87;
+    }
+
+    std::lock_guard<std::mutex> lock(s_registry_mutex);
+    auto& entry = s_registry[plan_key(bw_hop, ch_sep, freq_carrier, hop_rate, key)];
+    sptr plan = entry.lock();
+    if (!plan) {
+        plan = sptr(new hop_plan(bw_hop, ch_sep, freq_carrier, hop_rate, key));
+        entry = plan;
+    }
+    return plan;
+}
+
+hop_plan::hop_plan(
+    double bw_hop, double ch_sep, double freq_carrier, double hop_rate, uint64_t key)
+    : d_key(key)
+{
+    // 跳速用分数精确表示，时隙边界按分数计算，不会随时间累积误差
+    approximate_rational(hop_rate, RATE_MAX_DEN, d_rate_num, d_rate_den);
+    d_hop_rate = static_cast<double>(d_rate_num) / d_rate_den;
+    d_hop_period = static_cast<double>(d_rate_den) / d_rate_num;
+    d_slot_ns = static_cast<uint64_t>(d_hop_period * 1e9);
+    if (d_slot_ns == 0) {
+        throw std::invalid_argument("hop_rate is too high");
+    }
+
+    // 计算信道数量
+    int num_ch = static_cast<int>(std::floor(bw_hop / ch_sep));
+    if (num_ch < 1) {
+        num_ch = 1;
+    }
+
+    // 生成频率表
+    d_freq_vec.resize(num_ch);
+    for (int i = 0; i < num_ch; ++i) {
+        d_freq_vec[i] = (i - std::floor(num_ch / 2.0)) * ch_sep + freq_carrier;
+    }
+
+    // 跳频图案由时隙号直接计算
+    d_sequence = std::make_unique<hop_sequence>(num_ch, key);
+}
+
+hop_plan::~hop_plan() {}
+
+int hop_plan::channel(uint64_t slot) const { return d_sequence->channel(slot); }
+
+uint64_t hop_plan::to_ns(uint64_t sec, double frac_sec)
+{
+    return sec * 1000000000ULL + static_cast<uint64_t>(frac_sec * 1e9);
+}
+
+uint64_t hop_plan::slot_index(uint64_t time_ns) const
+{
+    // 时隙 k 从 k*den/num 秒开始
+    u128 t = static_cast<u128>(ns_since_midnight(time_ns)) * d_rate_num;
+    return static_cast<uint64_t>(t / (static_cast<u128>(d_rate_den) * NS_PER_SEC));
+}
+
+uint64_t hop_plan::slot_offset_ns(uint64_t time_ns) const
+{
+    u128 t = static_cast<u128>(ns_since_midnight(time_ns)) * d_rate_num;
+    u128 slot = static_cast<u128>(d_rate_den) * NS_PER_SEC;
+    return static_cast<uint64_t>(t % slot / d_rate_num);
+}
+
+uint64_t hop_plan::slot_start_ns(uint64_t time_ns, uint64_t slot) const
+{
+    // 当天0点加上 slot 个时隙
+    u128 t = static_cast<u128>(slot) * d_rate_den * NS_PER_SEC;
+    return time_ns - ns_since_midnight(time_ns) +
+           static_cast<uint64_t>((t + d_rate_num - 1) / d_rate_num);
+}
+
+uint64_t hop_plan::first_tx_slot(uint64_t time_ns) const
+{
+    // 当前slot的结尾时刻的编号，即下一slot的开始时刻的编号；
+    // 再+1是为了至少留1个slot处理
+    return slot_index(time_ns) + 2;
+}
+
+uint64_t hop_plan::slot_at_or_after(uint64_t time_ns) const
+{
+    u128 t = static_cast<u128>(ns_since_midnight(time_ns)) * d_rate_num;
+    u128 slot = static_cast<u128>(d_rate_den) * NS_PER_SEC;
+    return static_cast<uint64_t>((t + slot - 1) / slot);
+}
+
+std::shared_ptr<const phasor_table>
+hop_plan::mixer_table(double fs, int sign, int table_len) const
+{
+    if (fs <= 0) {
+        throw std::invalid_argument("mixer_table: fs must be positive");
+    }
+
+    std::lock_guard<std::mutex> lock(d_table_mutex);
+    auto& table = d_tables[std::make_tuple(fs, sign, table_len)];
+    if (!table) {
+        table = std::make_shared<const phasor_table>(d_freq_vec, fs, sign, table_len);
+    }
+    return table;
+}
+
+} // namespace freq_hopping
+} // namespace gr
@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "hop_sequence.h"
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+// Philox4x32 的乘数和密钥递增量（Salmon et al., SC'11）
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+const int PHILOX_ROUNDS = 10;
+} // namespace
+
+hop_sequence::hop_sequence(int num_ch, uint64_t key)
+    : d_num_ch(static_cast<uint32_t>(num_ch)), d_key(key)
+{
+    if (num_ch < 1) {
+        throw std::invalid_argument("hop_sequence: num_ch must be >= 1");
+    }
+}
+
+uint32_t hop_sequence::philox(uint64_t counter, uint64_t key)
+{
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+        uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n1 = static_cast<uint32_t>(p1);
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        uint32_t n3 = static_cast<uint32_t>(p0);
+        c0 = n0;
+        c1 = n1;
+        c2 = n2;
+        c3 = n3;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return c0;
+}
+
+int hop_sequence::channel(uint64_t slot) const
+{
+    // 32 位均匀数乘信道数取高位映射到 [0, num_ch)，偏差不超过 num_ch / 2^32
+    uint64_t x = philox(slot, d_key);
+    return static_cast<int>((x * d_num_ch) >> 32);
+}
+
+} // namespace freq_hopping
+} // namespace gr
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_SEQUENCE_H
+#define INCLUDED_FREQ_HOPPING_HOP_SEQUENCE_H
+
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <cstdint>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 基于计数器的带密钥跳频图案
+ *
+ * 第 slot 跳的信道号由 Philox4x32-10 对 (slot, key) 的一次计算得到，
+ * 不保存序列表，也没有随机数发生器状态：任意时隙都能 O(1) 直接求出。
+ * hop_plan 的时隙号从当天0点开始计，所以跳频图案每天从第 0 个时隙重新开始，
+ * 一天之内不重复。收发两端只要信道数和 key 相同，结果逐位一致。
+ */
+class hop_sequence
+{
+private:
+    uint32_t d_num_ch;
+    uint64_t d_key;
+
+public:
+    /*!
+     * \param num_ch 信道数，>= 1
+     * \param key 跳频图案密钥
+     */
+    explicit hop_sequence(int num_ch, uint64_t key = hop_plan::DEFAULT_KEY);
+
+    int num_channels() const { return static_cast<int>(d_num_ch); }
+    uint64_t key() const { return d_key; }
+
+    //! 第 slot 个时隙使用的信道号，范围 [0, num_ch)
+    int channel(uint64_t slot) const;
+
+    //! Philox4x32-10 输出的第一个 32 位字
+    static uint32_t philox(uint64_t counter, uint64_t key);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_SEQUENCE_H */
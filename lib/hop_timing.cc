@@ -0,0 +1,149 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "hop_timing.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+// 中间结果可能超过 64 位：tick 数乘以样点号、纳秒乘以采样率
+typedef unsigned __int128 u128;
+const uint64_t NS_PER_SEC = 1000000000ULL;
+// 采样率分母的上限
+const uint64_t FS_MAX_DEN = 1000000;
+
+u128 gcd128(u128 a, u128 b)
+{
+    while (b != 0) {
+        u128 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+} // namespace
+
+void approximate_rational(double x, uint64_t max_den, uint64_t& num, uint64_t& den)
+{
+    if (!(x > 0) || !std::isfinite(x)) {
+        throw std::invalid_argument("approximate_rational: x must be positive");
+    }
+
+    // 连分数的收敛子 h/k，取分母不超过 max_den 的最后一个
+    uint64_t h0 = 0, h1 = 1;
+    uint64_t k0 = 1, k1 = 0;
+    double r = x;
+    for (int i = 0; i < 64; ++i) {
+        double a = std::floor(r);
+        uint64_t ai = static_cast<uint64_t>(a);
+        uint64_t h2 = ai * h1 + h0;
+        uint64_t k2 = ai * k1 + k0;
+        if (k2 > max_den) {
+            break;
+        }
+        h0 = h1;
+        h1 = h2;
+        k0 = k1;
+        k1 = k2;
+
+        double f = r - a;
+        if (std::fabs(static_cast<double>(h1) / k1 - x) <= 1e-12 * x || f < 1e-12) {
+            break;
+        }
+        r = 1.0 / f;
+    }
+    num = h1;
+    den = k1;
+}
+
+hop_timing::hop_timing(hop_plan::sptr plan, double fs, int decim)
+    : d_plan(plan),
+      d_decim(decim),
+      d_anchored(false),
+      d_ref_slot(0),
+      d_anchor_output(0),
+      d_anchor_ticks(0),
+      d_anchor_input(0),
+      d_anchor_time_ns(0)
+{
+    if (decim < 1) {
+        throw std::invalid_argument("hop_timing: decim must be at least 1");
+    }
+    approximate_rational(fs, FS_MAX_DEN, d_fs_num, d_fs_den);
+
+    // 每跳输出样点数 = (fs/decim) / (p/q) = fs_num*q / (fs_den*decim*p)
+    u128 n = static_cast<u128>(d_fs_num) * plan->rate_den();
+    u128 d = static_cast<u128>(d_fs_den) * decim * plan->rate_num();
+    u128 g = gcd128(n, d);
+    n /= g;
+    d /= g;
+    if (n >> 64 || d >> 64) {
+        throw std::invalid_argument("hop_timing: sample rate and hop rate are too fine");
+    }
+    d_hop_ticks = static_cast<uint64_t>(n);
+    d_sample_ticks = static_cast<uint64_t>(d);
+}
+
+void hop_timing::anchor(uint64_t in_offset, uint64_t time_ns, uint64_t early_ns)
+{
+    const u128 p = d_plan->rate_num();
+    const u128 q = d_plan->rate_den();
+
+    // 锚点为标签之后的第一个输出样点，与标签相差 r 个输入样点
+    d_anchor_output = (in_offset + d_decim - 1) / d_decim;
+    uint64_t r = d_anchor_output * d_decim - in_offset;
+
+    // 时隙号和时隙内已经过的时间（以 1/p 纳秒为单位，精确）
+    uint64_t tsm = hop_plan::ns_since_midnight(time_ns);
+    d_ref_slot = d_plan->slot_index(time_ns);
+    u128 x = static_cast<u128>(tsm) * p - static_cast<u128>(d_ref_slot) * q * NS_PER_SEC +
+             static_cast<u128>(early_ns) * p;
+
+    // 换算为 tick：x/(p*1e9) 秒乘以输出采样率 fs/decim，再加上 r 个输入样点，乘以 D
+    // （先除后乘，避免中间结果溢出）
+    u128 num = x * d_fs_num + static_cast<u128>(r) * p * NS_PER_SEC * d_fs_den;
+    u128 den = p * NS_PER_SEC * d_fs_den * d_decim;
+    d_anchor_ticks =
+        static_cast<uint64_t>(num / den * d_sample_ticks + num % den * d_sample_ticks / den);
+    d_anchor_input = in_offset;
+    d_anchor_time_ns = time_ns;
+    d_anchored = true;
+}
+
+uint64_t hop_timing::expected_time_ns(uint64_t in_offset) const
+{
+    if (in_offset <= d_anchor_input) {
+        return d_anchor_time_ns;
+    }
+    // (in_offset - 锚点) / fs 秒，fs = fs_num/fs_den
+    u128 ns = static_cast<u128>(in_offset - d_anchor_input) * d_fs_den * NS_PER_SEC;
+    return d_anchor_time_ns + static_cast<uint64_t>(ns / d_fs_num);
+}
+
+uint64_t hop_timing::hop_of(uint64_t out_idx) const
+{
+    u128 ticks = static_cast<u128>(out_idx - d_anchor_output) * d_sample_ticks +
+                 d_anchor_ticks;
+    return static_cast<uint64_t>(ticks / d_hop_ticks);
+}
+
+uint64_t hop_timing::hop_start(uint64_t hop) const
+{
+    u128 ticks = static_cast<u128>(hop) * d_hop_ticks;
+    if (ticks <= d_anchor_ticks) {
+        return d_anchor_output;
+    }
+    ticks -= d_anchor_ticks;
+    return d_anchor_output +
+           static_cast<uint64_t>((ticks + d_sample_ticks - 1) / d_sample_ticks);
+}
+
+} // namespace freq_hopping
+} // namespace gr
@@ -0,0 +1,91 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_TIMING_H
+#define INCLUDED_FREQ_HOPPING_HOP_TIMING_H
+
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <cstdint>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 用分母不超过 max_den 的分数 num/den 逼近 x（连分数展开），x > 0
+ *
+ * 整数和 9600/87 这类有理数得到精确值。
+ */
+void approximate_rational(double x, uint64_t max_den, uint64_t& num, uint64_t& den);
+
+/*!
+ * \brief 接收端按样点号精确计算跳频边界
+ *
+ * 输出采样率 fs/decim 和跳速都表示为分数，每跳的输出样点数为 N/D。
+ * 以 tick 计时，1 个输出样点 = D tick，1 跳 = N tick，全部为整数运算：
+ * 输出样点 m 所在的跳为 floor(((m - A)*D + T0) / N)，其中 A 为锚点输出样点，
+ * T0 为锚点处已进入当前时隙的 tick 数。任意样点号都能 O(1) 求出，
+ * 不累加浮点数，运行多久边界都不会漂移。
+ */
+class hop_timing
+{
+private:
+    hop_plan::sptr d_plan;
+    int d_decim;
+    uint64_t d_fs_num; // 输入采样率 = d_fs_num / d_fs_den
+    uint64_t d_fs_den;
+    uint64_t d_hop_ticks;    // N
+    uint64_t d_sample_ticks; // D
+
+    bool d_anchored;
+    uint64_t d_ref_slot;       // 锚点所在时隙号
+    uint64_t d_anchor_output;  // A
+    uint64_t d_anchor_ticks;   // T0
+    uint64_t d_anchor_input;   // 锚定时间标签所在的输入样点
+    uint64_t d_anchor_time_ns; // 该样点的时刻
+
+public:
+    /*!
+     * \param plan 跳频方案
+     * \param fs 输入采样率（Hz）
+     * \param decim 输出抽取倍数
+     */
+    hop_timing(hop_plan::sptr plan, double fs, int decim);
+
+    //! 每跳的输出样点数（仅用于显示）
+    double samples_per_hop() const
+    {
+        return static_cast<double>(d_hop_ticks) / d_sample_ticks;
+    }
+
+    /*!
+     * 以时间标签锚定：输入样点 in_offset 处的时刻为 time_ns（从 epoch 开始）。
+     * 锚点取该样点之后的第一个输出样点；early_ns 为提前切换频率的时间。
+     */
+    void anchor(uint64_t in_offset, uint64_t time_ns, uint64_t early_ns);
+
+    bool anchored() const { return d_anchored; }
+    uint64_t ref_slot() const { return d_ref_slot; }
+    uint64_t anchor_output() const { return d_anchor_output; }
+
+    //! 输出样点 out_idx（>= 锚点）所在的跳数，相对锚点时隙
+    uint64_t hop_of(uint64_t out_idx) const;
+    //! 第 hop 跳（相对锚点时隙，hop >= 1）的第一个输出样点
+    uint64_t hop_start(uint64_t hop) const;
+    //! 输出样点 out_idx（>= 锚点）所在的时隙号
+    uint64_t slot_of(uint64_t out_idx) const { return d_ref_slot + hop_of(out_idx); }
+
+    /*!
+     * 按当前锚点推算输入样点 in_offset（>= 锚定标签所在样点）的时刻（纳秒）。
+     * 新的时间标签与推算值不一致说明中间丢了样点（USRP 溢出）或设备时间被重设。
+     */
+    uint64_t expected_time_ns(uint64_t in_offset) const;
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_TIMING_H */
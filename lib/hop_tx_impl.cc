@@ -0,0 +1,308 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "hop_tx_impl.h"
+#include "bb_pskmod_impl.h"
+#include <gnuradio/io_signature.h>
+
+namespace gr {
+namespace freq_hopping {
+
+using input_type = int;
+using output_type = gr_complex;
+hop_tx::sptr hop_tx::make(int hop_rate,
+                          int M_order,
+                          int Ksa_ch,
+                          int interp_fac,
+                          double bw_hop,
+                          double ch_sep,
+                          double freq_carrier,
+                          double fsa_hop,
+                          int clock,
+                          double lead_time,
+                          double epoch,
+                          uint64_t key)
+{
+    return gnuradio::make_block_sptr<hop_tx_impl>(hop_rate,
+                                                  M_order,
+                                                  Ksa_ch,
+                                                  interp_fac,
+                                                  bw_hop,
+                                                  ch_sep,
+                                                  freq_carrier,
+                                                  fsa_hop,
+                                                  clock,
+                                                  lead_time,
+                                                  epoch,
+                                                  key);
+}
+
+// 每块插值后的样点数上限，块内数据留在 L1/L2 缓存中
+static const int HOP_TX_CHUNK_SAMPLES = 4096;
+
+static const pmt::pmt_t HOP_TX_TIME_PORT = pmt::mp("time");
+
+
+/*
+ * The private constructor
+ */
+hop_tx_impl::hop_tx_impl(int hop_rate,
+                         int M_order,
+                         int Ksa_ch,
+                         int interp_fac,
+                         double bw_hop,
+                         double ch_sep,
+                         double freq_carrier,
+                         double fsa_hop,
+                         int clock,
+                         double lead_time,
+                         double epoch,
+                         uint64_t key)
+    : gr::sync_block(
+          "hop_tx",
+          gr::io_signature::make(1,
+                                 1,
+                                 sizeof(input_type) *
+                                     bb_pskmod_impl::calculate_input_length(hop_rate)),
+          gr::io_signature::make(
+              1,
+              1,
+              sizeof(output_type) * interp_fac *
+                  bb_pskmod_impl::calculate_output_length(hop_rate, Ksa_ch))),
+      d_M_order(M_order),
+      d_Ksa_ch(Ksa_ch),
+      d_interp_fac(interp_fac),
+      d_fsa_hop(fsa_hop),
+      d_rrc_span(8),
+      d_rrc_filter(nullptr),
+      d_interpolator(interp_fac),
+      d_nco(nullptr),
+      d_hop_count(0),
+      d_first_hop(true),
+      d_lead_ns(0),
+      d_simulated(false),
+      d_start_time(0),
+      d_start_item(0)
+{
+    // 参数验证
+    if (d_M_order != 2 && d_M_order != 4 && d_M_order != 8) {
+        throw std::invalid_argument("M_order must be 2, 4, or 8");
+    }
+    if (d_Ksa_ch <= 0) {
+        throw std::invalid_argument("Ksa_ch must be positive");
+    }
+    if (d_interp_fac <= 0) {
+        throw std::invalid_argument("interp_fac must be positive");
+    }
+    if (d_fsa_hop <= 0) {
+        throw std::invalid_argument("fsa_hop must be positive");
+    }
+    if (hop_rate <= 0) {
+        throw std::invalid_argument("hop_rate must be positive");
+    }
+    if (clock < time_source::HOST || clock > time_source::SIMULATED) {
+        throw std::invalid_argument("clock must be 0 (host), 1 (device) or 2 (simulated)");
+    }
+    if (lead_time < 0) {
+        throw std::invalid_argument("lead_time must not be negative");
+    }
+    if (epoch < 0) {
+        throw std::invalid_argument("epoch must not be negative");
+    }
+    d_time_source = time_source::make(static_cast<time_source::source_type>(clock),
+                                      static_cast<uint64_t>(epoch * 1e9));
+    d_simulated = d_time_source->type() == time_source::SIMULATED;
+    d_lead_ns = static_cast<uint64_t>(lead_time * 1e9);
+
+    // 频率表和跳频序列（与 hop_mod 共享同一个 hop_plan，同时检查 bw_hop 和 ch_sep）
+    d_plan = hop_plan::make(bw_hop, ch_sep, freq_carrier, hop_rate, key);
+
+    // 帧长度（与 bb_pskmod、hop_interp 相同）
+    d_input_frame_len = bb_pskmod_impl::calculate_input_length(hop_rate);
+    d_bb_frame_len = bb_pskmod_impl::calculate_output_length(hop_rate, d_Ksa_ch);
+    d_output_frame_len = d_bb_frame_len * d_interp_fac;
+
+    // 星座图和RRC成形滤波器（与 bb_pskmod 相同）
+    d_constellation = bb_pskmod_impl::make_constellation(d_M_order);
+    d_rrc_taps = bb_pskmod_impl::design_rrc_taps(d_Ksa_ch, d_rrc_span);
+    d_rrc_filter =
+        firinterp_crcf_create(d_Ksa_ch, d_rrc_taps.data(), d_rrc_taps.size());
+
+    d_nco = nco_crcf_create(LIQUID_VCO);
+
+    // 中间缓冲
+    d_chunk_len = std::max(1, HOP_TX_CHUNK_SAMPLES / d_interp_fac);
+    if (d_bb_frame_len < d_input_frame_len * d_Ksa_ch) {
+        throw std::invalid_argument("output frame is shorter than the shaped input frame");
+    }
+    int num_sym_transition = (d_rrc_span >> 1) - 1;
+    d_sym_buf.assign(d_input_frame_len + num_sym_transition, gr_complex(0, 0));
+    d_bb.assign(d_bb_frame_len, gr_complex(0, 0));
+    d_chunk.resize(std::max(d_chunk_len * d_interp_fac, num_sym_transition * d_Ksa_ch));
+
+    // 设备时间：(整数秒, 小数秒) 元组，或含 rx_time/time 键的字典
+    message_port_register_in(HOP_TX_TIME_PORT);
+    set_msg_handler(HOP_TX_TIME_PORT,
+                    [this](const pmt::pmt_t& msg) { handle_time_msg(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+hop_tx_impl::~hop_tx_impl()
+{
+    if (d_rrc_filter) {
+        firinterp_crcf_destroy(d_rrc_filter);
+    }
+    if (d_nco) {
+        nco_crcf_destroy(d_nco);
+    }
+}
+
+void hop_tx_impl::set_time_source(time_source::sptr source)
+{
+    if (!source) {
+        throw std::invalid_argument("time source must not be null");
+    }
+    // 仿真时间与否跟随新时钟，而不是构造时的 clock 参数
+    d_time_source = source;
+    d_simulated = source->type() == time_source::SIMULATED;
+}
+
+void hop_tx_impl::handle_time_msg(const pmt::pmt_t& msg)
+{
+    pmt::pmt_t time = msg;
+    if (pmt::is_dict(msg)) {
+        time = pmt::dict_ref(msg, pmt::mp("rx_time"), pmt::PMT_NIL);
+        if (pmt::is_null(time)) {
+            time = pmt::dict_ref(msg, HOP_TX_TIME_PORT, pmt::PMT_NIL);
+        }
+    }
+    if (!pmt::is_tuple(time) || pmt::length(time) < 2) {
+        std::cerr << "Warning: hop_tx time message must be a (sec, frac_sec) tuple"
+                  << std::endl;
+        return;
+    }
+
+    uint64_t sec = pmt::to_uint64(pmt::tuple_ref(time, 0));
+    double frac_sec = pmt::to_double(pmt::tuple_ref(time, 1));
+    d_time_source->set_time(hop_plan::to_ns(sec, frac_sec));
+}
+
+uint64_t hop_tx_impl::virtual_time_ns(uint64_t item) const
+{
+    double elapsed =
+        static_cast<double>(item - d_start_item) * d_output_frame_len / d_fsa_hop;
+    return d_start_time + static_cast<uint64_t>(elapsed * 1e9);
+}
+
+uint64_t hop_tx_impl::align_to_time_slot(uint64_t current_time_ns)
+{
+    // 下一slot的开始时刻的编号，再+1至少留1个slot处理，再额外提前 lead_time。
+    // 仿真时间没有处理延迟，直接取下一个时隙边界
+    uint64_t real_tx_slot_idx =
+        d_simulated ? d_plan->slot_at_or_after(current_time_ns + d_lead_ns)
+                    : d_plan->first_tx_slot(current_time_ns + d_lead_ns);
+
+    // 按照真实发送时刻的编号来初始化d_hop_count
+    d_hop_count = real_tx_slot_idx;
+    std::cout << "TX: FIRST HOP: idx: " << d_hop_count << std::endl;
+
+    // 计算绝对时间（从epoch开始），按跳速的分数精确换算
+    uint64_t real_tx_start =
+        d_plan->slot_start_ns(current_time_ns + d_lead_ns, real_tx_slot_idx);
+    std::cout << "TX: FIRST HOP: real_tx_start: " << real_tx_start << std::endl;
+    return real_tx_start;
+}
+
+void hop_tx_impl::add_tx_time_tag()
+{
+    // 获取当前时间（纳秒），对齐到下一个时隙开始
+    d_start_time = align_to_time_slot(d_time_source->now_ns());
+    d_start_item = nitems_written(0);
+
+    // 转换为秒，并拆分为整数部分和小数部分
+    uint64_t integer_sec = d_start_time / 1000000000ULL;
+    double fractional_sec = (d_start_time % 1000000000ULL) / 1e9;
+
+    add_item_tag(0,
+                 nitems_written(0),
+                 pmt::string_to_symbol("tx_time"),
+                 pmt::make_tuple(pmt::from_uint64(integer_sec),
+                                 pmt::from_double(fractional_sec)));
+}
+
+void hop_tx_impl::modulate_frame(const int* frame_in)
+{
+    // 与 bb_pskmod 相同：整帧查表映射，越界的符号映射到第一个星座点
+    const unsigned M = d_constellation.size();
+    for (int i = 0; i < d_input_frame_len; ++i) {
+        unsigned idx = static_cast<unsigned>(frame_in[i]);
+        d_sym_buf[i] = d_constellation[idx < M ? idx : 0];
+    }
+
+    // 丢弃前 num_sym_transition 个符号的输出，帧尾补 num_sym_transition 个零符号
+    int num_sym_transition = (d_rrc_span >> 1) - 1;
+    firinterp_crcf_execute_block(
+        d_rrc_filter, d_sym_buf.data(), num_sym_transition, d_chunk.data());
+    firinterp_crcf_execute_block(
+        d_rrc_filter, d_sym_buf.data() + num_sym_transition, d_input_frame_len, d_bb.data());
+}
+
+int hop_tx_impl::work(int noutput_items,
+                      gr_vector_const_void_star& input_items,
+                      gr_vector_void_star& output_items)
+{
+    auto in = static_cast<const input_type*>(input_items[0]);
+    auto out = static_cast<output_type*>(output_items[0]);
+
+    // 第一跳打 tx_time 标签；设备时钟尚未给出时间时不输出，等待 time 消息
+    if (d_first_hop) {
+        if (!d_time_source->valid()) {
+            return 0;
+        }
+        add_tx_time_tag();
+        d_first_hop = false;
+    }
+
+    int idx_frame = 0;
+    for (; idx_frame < noutput_items; ++idx_frame) {
+        const input_type* frame_in = in + idx_frame * d_input_frame_len;
+        output_type* frame_out = out + idx_frame * d_output_frame_len;
+
+        // 星座映射 + RRC成形，一跳基带样点只有几百个
+        modulate_frame(frame_in);
+
+        // 为当前帧选择频率，每帧从零相位开始
+        double freq_tb = d_plan->slot_frequency(d_hop_count);
+        nco_crcf_set_phase(d_nco, 0);
+        nco_crcf_set_frequency(d_nco, 2 * M_PI * freq_tb / d_fsa_hop);
+
+        // 按块插值并直接上混频写入输出
+        for (int i = 0; i < d_bb_frame_len; i += d_chunk_len) {
+            int n = std::min(d_chunk_len, d_bb_frame_len - i);
+            d_interpolator.execute(&d_bb[i], n, d_chunk.data());
+            nco_crcf_mix_block_up(
+                d_nco, d_chunk.data(), frame_out + i * d_interp_fac, n * d_interp_fac);
+        }
+        d_interpolator.reset();
+
+        // 增加跳频计数器
+        d_hop_count++;
+    }
+
+    // 仿真时间：时钟推进到本次输出结束的时刻，与共享该时钟的其他块保持一致
+    if (d_simulated) {
+        d_time_source->set_time(virtual_time_ns(nitems_written(0) + idx_frame));
+    }
+
+    // Tell runtime system how many output items we produced.
+    return idx_frame;
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
@@ -0,0 +1,103 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_HOP_TX_IMPL_H
+#define INCLUDED_FREQ_HOPPING_HOP_TX_IMPL_H
+
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/freq_hopping/hop_tx.h>
+
+#include <liquid/liquid.h>
+
+#include "cascade_resampler.h"
+
+#include <memory>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+class hop_tx_impl : public hop_tx
+{
+private:
+    // 调制参数
+    int d_M_order;
+    int d_Ksa_ch;
+    int d_interp_fac;
+
+    // 跳频参数
+    double d_fsa_hop;       // 跳频采样率
+    hop_plan::sptr d_plan;  // 频率表、跳频图案和时隙换算
+
+    // 帧长度
+    int d_input_frame_len;  // 每跳符号数
+    int d_bb_frame_len;     // 每跳基带样点数
+    int d_output_frame_len; // 每跳输出样点数
+
+    // 星座图和成形滤波器
+    std::vector<gr_complex> d_constellation;
+    int d_rrc_span;
+    std::vector<float> d_rrc_taps;
+    firinterp_crcf d_rrc_filter;
+
+    // 插值器
+    cascade_interpolator d_interpolator;
+
+    // 上混频
+    nco_crcf d_nco;
+    uint64_t d_hop_count;
+    bool d_first_hop;
+
+    // 第一跳对齐所用的时钟和额外提前量（纳秒）
+    time_source::sptr d_time_source;
+    uint64_t d_lead_ns;
+
+    // 仿真时间：时钟随输出样点推进，d_start_item 为第一跳的输出向量号
+    bool d_simulated;
+    uint64_t d_start_time;
+    uint64_t d_start_item;
+
+    // 单跳内的中间缓冲：一跳基带样点，以及一小块插值后的样点
+    int d_chunk_len;                 // 每块基带样点数
+    std::vector<gr_complex> d_sym_buf; // 一跳符号，后接冲洗滤波器的零符号
+    std::vector<gr_complex> d_bb;    // d_bb_frame_len，成形输出之后的部分保持为0
+    std::vector<gr_complex> d_chunk; // d_chunk_len * d_interp_fac
+
+    uint64_t align_to_time_slot(uint64_t current_time_ns);
+    void add_tx_time_tag();
+    void handle_time_msg(const pmt::pmt_t& msg);
+    // 仿真时间下第 item 个输出向量的时刻（纳秒）
+    uint64_t virtual_time_ns(uint64_t item) const;
+    void modulate_frame(const int* frame_in);
+
+public:
+    hop_tx_impl(int hop_rate,
+                int M_order,
+                int Ksa_ch,
+                int interp_fac,
+                double bw_hop,
+                double ch_sep,
+                double freq_carrier,
+                double fsa_hop,
+                int clock,
+                double lead_time,
+                double epoch,
+                uint64_t key);
+    ~hop_tx_impl();
+
+    void set_time_source(time_source::sptr source) override;
+
+    // Where all the action really happens
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_HOP_TX_IMPL_H */
@@ -0,0 +1,81 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "phasor_table.h"
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+// 归一化频率 f/fs 乘以样点数后取小数部分再求复指数，避免大相位下的精度损失
+gr_complex unit_phasor(double cycles, int sign)
+{
+    double frac = cycles - std::floor(cycles);
+    double theta = sign * 2 * M_PI * frac;
+    return gr_complex(static_cast<float>(std::cos(theta)),
+                      static_cast<float>(std::sin(theta)));
+}
+} // namespace
+
+phasor_table::phasor_table(const std::vector<double>& freqs,
+                           double fs,
+                           int sign,
+                           int table_len)
+    : d_num_ch(static_cast<int>(freqs.size())), d_table_len(table_len)
+{
+    if (fs <= 0) {
+        throw std::invalid_argument("phasor_table: fs must be positive");
+    }
+    if (sign != 1 && sign != -1) {
+        throw std::invalid_argument("phasor_table: sign must be +1 or -1");
+    }
+    if (d_table_len < 0) {
+        throw std::invalid_argument("phasor_table: table_len must not be negative");
+    }
+
+    d_phase_incr.resize(d_num_ch);
+    d_table_step.resize(d_num_ch);
+    d_table.resize(static_cast<size_t>(d_num_ch) * d_table_len);
+
+    for (int ch = 0; ch < d_num_ch; ++ch) {
+        double f_norm = freqs[ch] / fs;
+        d_phase_incr[ch] = unit_phasor(f_norm, sign);
+        d_table_step[ch] = unit_phasor(f_norm * d_table_len, sign);
+
+        gr_complex* tab = &d_table[static_cast<size_t>(ch) * d_table_len];
+        for (int n = 0; n < d_table_len; ++n) {
+            tab[n] = unit_phasor(f_norm * n, sign);
+        }
+    }
+}
+
+void phasor_table::mix(int ch, const gr_complex* in, gr_complex* out, int n) const
+{
+    const gr_complex* tab = &d_table[static_cast<size_t>(ch) * d_table_len];
+    const gr_complex step = d_table_step[ch];
+    gr_complex phase(1.0f, 0.0f);
+
+    // 按表长分块：块内查表相乘，块间再乘以该块的起始相位
+    for (int k = 0; k < n; k += d_table_len) {
+        int len = std::min(d_table_len, n - k);
+        volk_32fc_x2_multiply_32fc(out + k, in + k, tab, len);
+        if (k > 0) {
+            volk_32fc_s32fc_multiply_32fc(out + k, out + k, phase, len);
+        }
+
+        // 推进到下一块的起始相位，并归一化幅度防止累积误差
+        phase *= step;
+        phase /= std::abs(phase);
+    }
+}
+
+} // namespace freq_hopping
+} // namespace gr
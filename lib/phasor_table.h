@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_FREQ_HOPPING_PHASOR_TABLE_H
+#define INCLUDED_FREQ_HOPPING_PHASOR_TABLE_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+/*!
+ * \brief 按信道预计算的混频相量表
+ *
+ * 构造时为频率表中的每个信道计算一次：
+ *  - 每样点相位增量 exp(j*sign*2*pi*f/fs)，供旋转器直接使用；
+ *  - 长度为 table_len 的复指数表 exp(j*sign*2*pi*f*n/fs)，以及
+ *    跨越一整张表的相位步进 exp(j*sign*2*pi*f*table_len/fs)。
+ * 热路径中混频只剩查表后的复数乘法，没有三角函数运算。
+ */
+class phasor_table
+{
+private:
+    int d_num_ch;
+    int d_table_len;
+    std::vector<gr_complex> d_phase_incr; // 每信道的每样点相位增量
+    std::vector<gr_complex> d_table_step; // 每信道跨一张表的相位步进
+    std::vector<gr_complex> d_table;      // d_num_ch * d_table_len
+
+public:
+    /*!
+     * \param freqs 各信道频率（Hz）
+     * \param fs 采样率（Hz）
+     * \param sign +1 为上混频，-1 为下混频
+     * \param table_len 每信道复指数表的长度，为 0 时只计算相位增量
+     */
+    phasor_table(const std::vector<double>& freqs, double fs, int sign, int table_len);
+
+    int num_channels() const { return d_num_ch; }
+    int table_len() const { return d_table_len; }
+
+    //! 信道 ch 的每样点相位增量
+    gr_complex phase_incr(int ch) const { return d_phase_incr[ch]; }
+
+    /*!
+     * 从零相位开始，用信道 ch 的相量表混频 n 个样点：
+     * out[k] = in[k] * exp(j*sign*2*pi*f*k/fs)
+     * 需要 table_len > 0。
+     */
+    void mix(int ch, const gr_complex* in, gr_complex* out, int n) const;
+};
+
+} // namespace freq_hopping
+} // namespace gr
+
+#endif /* INCLUDED_FREQ_HOPPING_PHASOR_TABLE_H */
@@ -211,5 +211,98 @@ BOOST_AUTO_TEST_CASE(test_bb_pskmod_frame_length_calculation)
     BOOST_CHECK_GE(output_length, input_length * Ksa_ch);
 }
 
+BOOST_AUTO_TEST_CASE(test_bb_pskmod_bulk_mapping)
+{
+    // 越界符号映射到第一个星座点；成形输出之后的帧尾为0
+    int hop_rate = 20;
+    int M_order = 4;
+    int Ksa_ch = 4;
+    int num_frames = 3;
+
+    int input_length = bb_pskmod_impl::calculate_input_length(hop_rate);
+    int output_length = bb_pskmod_impl::calculate_output_length(hop_rate, Ksa_ch);
+
+    std::vector<int> zero_data(input_length * num_frames, 0);
+    std::vector<int> bad_data(input_length * num_frames);
+    for (size_t i = 0; i < bad_data.size(); i++) {
+        bad_data[i] = (i % 2) ? -1 : M_order + 5;
+    }
+
+    auto src0 = gr::blocks::vector_source_i::make(zero_data, false, input_length);
+    auto mod0 = bb_pskmod::make(hop_rate, M_order, Ksa_ch);
+    auto sink0 = gr::blocks::vector_sink_c::make(output_length);
+    auto src1 = gr::blocks::vector_source_i::make(bad_data, false, input_length);
+    auto mod1 = bb_pskmod::make(hop_rate, M_order, Ksa_ch);
+    auto sink1 = gr::blocks::vector_sink_c::make(output_length);
+
+    auto tb = gr::make_top_block("test_bulk_mapping");
+    tb->connect(src0, 0, mod0, 0);
+    tb->connect(mod0, 0, sink0, 0);
+    tb->connect(src1, 0, mod1, 0);
+    tb->connect(mod1, 0, sink1, 0);
+    tb->run();
+
+    auto out0 = sink0->data();
+    auto out1 = sink1->data();
+    BOOST_REQUIRE_EQUAL(out0.size(), num_frames * output_length);
+    BOOST_REQUIRE_EQUAL(out1.size(), out0.size());
+
+    for (size_t i = 0; i < out0.size(); i++) {
+        BOOST_CHECK_EQUAL(out0[i], out1[i]);
+        if (static_cast<int>(i % output_length) >= input_length * Ksa_ch) {
+            BOOST_CHECK_EQUAL(out0[i], gr_complex(0, 0));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bb_pskmod_streaming)
+{
+    // 流式模式：帧内部的样点与复位模式相同，只是多延迟了 num_sym_transition 个符号
+    int hop_rate = 20;
+    int M_order = 4;
+    int Ksa_ch = 4;
+    int num_frames = 4;
+    int num_sym_transition = 3; // rrc_span/2 - 1
+    int span = 8;
+
+    int input_length = bb_pskmod_impl::calculate_input_length(hop_rate);
+    int output_length = bb_pskmod_impl::calculate_output_length(hop_rate, Ksa_ch);
+
+    std::vector<int> test_data(input_length * num_frames);
+    for (size_t i = 0; i < test_data.size(); i++) {
+        test_data[i] = (i * 5 + i / 7) % M_order;
+    }
+
+    auto src0 = gr::blocks::vector_source_i::make(test_data, false, input_length);
+    auto mod0 = bb_pskmod::make(hop_rate, M_order, Ksa_ch, false);
+    auto sink0 = gr::blocks::vector_sink_c::make(output_length);
+    auto src1 = gr::blocks::vector_source_i::make(test_data, false, input_length);
+    auto mod1 = bb_pskmod::make(hop_rate, M_order, Ksa_ch, true);
+    auto sink1 = gr::blocks::vector_sink_c::make(output_length);
+
+    auto tb = gr::make_top_block("test_streaming");
+    tb->connect(src0, 0, mod0, 0);
+    tb->connect(mod0, 0, sink0, 0);
+    tb->connect(src1, 0, mod1, 0);
+    tb->connect(mod1, 0, sink1, 0);
+    tb->run();
+
+    auto reset_out = sink0->data();
+    auto stream_out = sink1->data();
+    BOOST_REQUIRE_EQUAL(reset_out.size(), num_frames * output_length);
+    BOOST_REQUIRE_EQUAL(stream_out.size(), reset_out.size());
+
+    for (int k = 0; k < num_frames; k++) {
+        const gr_complex* r = reset_out.data() + k * output_length;
+        const gr_complex* s = stream_out.data() + k * output_length;
+        for (int n = span * Ksa_ch; n < (input_length - span) * Ksa_ch; n++) {
+            BOOST_CHECK_SMALL(std::abs(r[n] - s[n + num_sym_transition * Ksa_ch]), 1e-5f);
+        }
+    }
+
+    // 110 hops/s 时每帧样点数不是每符号样点数的整数倍
+    BOOST_CHECK_NO_THROW(bb_pskmod::make(110, M_order, Ksa_ch, true));
+}
+
 } /* namespace freq_hopping */
-} /* namespace gr */
\ No newline at end of file
+} /* namespace gr */
@@ -0,0 +1,145 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/blocks/message_debug.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include <complex>
+#include <vector>
+
+#include <gnuradio/freq_hopping/frame_recover.h>
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_frame_recover_windows)
+{
+    // 输入为斜坡 0,1,2,...，输出值即为被保留样点的位置
+    const int frame_len = 50;
+    std::vector<gr_complex> in_data(20000);
+    for (size_t k = 0; k < in_data.size(); ++k) {
+        in_data[k] = gr_complex((float)k, 0.0f);
+    }
+
+    // 第二个标签落在第一帧内部，应从该点重新开始计数
+    std::vector<uint64_t> offsets = { 100, 130, 9000, 19990 };
+    std::vector<tag_t> tags;
+    for (uint64_t off : offsets) {
+        tag_t t;
+        t.offset = off;
+        t.key = pmt::mp("phase_est");
+        t.value = pmt::from_double(0.0);
+        tags.push_back(t);
+    }
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto recover = frame_recover::make(frame_len);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_frame_recover");
+    tb->connect(src, 0, recover, 0);
+    tb->connect(recover, 0, sink, 0);
+    tb->run();
+
+    std::vector<float> expected;
+    for (int k = 100; k < 130 + frame_len; ++k) {
+        expected.push_back((float)k);
+    }
+    for (int k = 9000; k < 9000 + frame_len; ++k) {
+        expected.push_back((float)k);
+    }
+    for (int k = 19990; k < 20000; ++k) { // 流结束，最后一帧不完整
+        expected.push_back((float)k);
+    }
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        BOOST_CHECK_EQUAL(out_data[k].real(), expected[k]);
+    }
+
+    // 每个标签都转发到对应的输出位置
+    auto out_tags = sink->tags();
+    BOOST_REQUIRE_EQUAL(out_tags.size(), offsets.size());
+    BOOST_CHECK_EQUAL(out_tags[0].offset, 0);
+    BOOST_CHECK_EQUAL(out_tags[1].offset, 30);
+    BOOST_CHECK_EQUAL(out_tags[2].offset, 30 + frame_len);
+    BOOST_CHECK_EQUAL(out_tags[3].offset, 30 + 2 * frame_len);
+}
+
+BOOST_AUTO_TEST_CASE(test_frame_recover_pdu)
+{
+    // PDU 模式：只连消息端口，流输出不连接
+    const int frame_len = 20;
+    std::vector<gr_complex> in_data(500);
+    for (size_t k = 0; k < in_data.size(); ++k) {
+        in_data[k] = gr_complex((float)k, 0.0f);
+    }
+
+    // 第一帧在 60 处被第二个标签打断，不应发出；490 处的帧到流结束也不完整
+    std::vector<tag_t> tags;
+    auto push = [&tags](uint64_t offset, const char* key, double value) {
+        tag_t t;
+        t.offset = offset;
+        t.key = pmt::mp(key);
+        t.value = pmt::from_double(value);
+        tags.push_back(t);
+    };
+    push(50, "phase_est", 0.1);
+    push(60, "phase_est", 0.2);
+    push(60, "corr_est", 7.5);
+    push(300, "phase_est", 0.3);
+    push(490, "phase_est", 0.4);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto recover = frame_recover::make(frame_len, true);
+    auto dbg = blocks::message_debug::make();
+
+    auto tb = gr::make_top_block("test_frame_recover_pdu");
+    tb->connect(src, 0, recover, 0);
+    tb->msg_connect(recover, "pdus", dbg, "store");
+    tb->run();
+
+    BOOST_REQUIRE_EQUAL(dbg->num_messages(), 2);
+
+    const uint64_t starts[] = { 60, 300 };
+    const double phases[] = { 0.2, 0.3 };
+    for (int m = 0; m < 2; ++m) {
+        pmt::pmt_t pdu = dbg->get_message(m);
+        pmt::pmt_t meta = pmt::car(pdu);
+        pmt::pmt_t vec = pmt::cdr(pdu);
+
+        BOOST_CHECK_EQUAL(
+            pmt::to_uint64(pmt::dict_ref(meta, pmt::mp("offset"), pmt::get_PMT_NIL())),
+            starts[m]);
+        BOOST_CHECK_CLOSE(
+            pmt::to_double(pmt::dict_ref(meta, pmt::mp("phase_est"), pmt::get_PMT_NIL())),
+            phases[m],
+            1e-6);
+
+        size_t len = 0;
+        const gr_complex* samples = pmt::c32vector_elements(vec, len);
+        BOOST_REQUIRE_EQUAL(len, (size_t)frame_len);
+        for (int k = 0; k < frame_len; ++k) {
+            BOOST_CHECK_EQUAL(samples[k].real(), (float)(starts[m] + k));
+        }
+    }
+
+    // 只有第一帧带 corr_est
+    BOOST_CHECK(pmt::dict_has_key(pmt::car(dbg->get_message(0)), pmt::mp("corr_est")));
+    BOOST_CHECK(!pmt::dict_has_key(pmt::car(dbg->get_message(1)), pmt::mp("corr_est")));
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
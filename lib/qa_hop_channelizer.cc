@@ -0,0 +1,185 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/freq_hopping/hop_channelizer.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_hop_channelizer_parameter_validation)
+{
+    std::cout << "=== Test 1: Parameter Validation ===" << std::endl;
+
+    // 两个网络，抽取 4 倍
+    auto chan = hop_channelizer::make(12e3, 3e3, 0, 48e3, 5, 4, { 0, 3 });
+    BOOST_CHECK(chan != nullptr);
+    BOOST_CHECK_EQUAL(chan->output_signature()->min_streams(), 2);
+    BOOST_CHECK_EQUAL(chan->decimation(), 4u);
+
+    // 抽取后的采样率必须大于信道间隔
+    BOOST_CHECK_THROW(hop_channelizer::make(12e3, 3e3, 0, 48e3, 5, 16),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(hop_channelizer::make(12e3, 3e3, 0, 48e3, 5, 4, {}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(hop_channelizer::make(12e3, 3e3, 0, 48e3, 5, 4, { 0, -1 }),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_channelizer_single_channel)
+{
+    std::cout << "\n=== Test 2: Single Channel Across Hop Boundaries ===" << std::endl;
+
+    // 只有一个信道，解跳后应为相位连续的直流，两个网络的输出相同
+    double bw_hop = 3e3;
+    double ch_sep = 3e3;
+    double freq_carrier = 1e3;
+    double fsa_hop = 48e3;
+    double hop_rate = 110; // 非整数的每跳样点数
+    int decim = 4;
+    int num_samples = 16384;
+
+    std::vector<gr_complex> in_data(num_samples);
+    for (int n = 0; n < num_samples; n++) {
+        in_data[n] = std::exp(gr_complex(0, 2 * M_PI * freq_carrier * n / fsa_hop));
+    }
+
+    // 在第一个样点打 rx_time 标签
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = 0;
+    t.key = pmt::mp("rx_time");
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.0123));
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto chan = hop_channelizer::make(
+        bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate, decim, { 0, 1 });
+    auto sink0 = blocks::vector_sink_c::make();
+    auto sink1 = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_hop_channelizer");
+    tb->connect(src, 0, chan, 0);
+    tb->connect(chan, 0, sink0, 0);
+    tb->connect(chan, 1, sink1, 0);
+    tb->run();
+
+    auto out0 = sink0->data();
+    auto out1 = sink1->data();
+    BOOST_REQUIRE_EQUAL(out0.size(), out1.size());
+    BOOST_REQUIRE_GT(out0.size(), 1024u);
+
+    // 跳过滤波器的起始暂态
+    const size_t skip = 512;
+    for (size_t n = skip; n < out0.size(); n++) {
+        BOOST_CHECK_SMALL(std::abs(out0[n]) - 1.0f, 1e-2f);
+        BOOST_CHECK_SMALL(std::abs(out0[n] - out0[skip]), 1e-2f);
+        BOOST_CHECK_SMALL(std::abs(out1[n] - out0[n]), 1e-5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_channelizer_multi_channel)
+{
+    std::cout << "\n=== Test 3: Multi-Channel Hopping Signal ===" << std::endl;
+
+    // 4 个信道，每跳 9600 个输入样点；输入按 hop_plan 的跳频图案逐时隙换频，
+    // rx_time 标签落在时隙中间
+    double bw_hop = 12e3;
+    double ch_sep = 3e3;
+    double fsa_hop = 48e3;
+    double hop_rate = 5;
+    int decim = 4;
+    int num_hops = 8;
+    double samples_per_hop = fsa_hop / hop_rate;
+    uint64_t sec = 1000;
+    double frac_sec = 0.0123;
+    uint64_t first_slot = 5000; // 1000 s 正好是第 5000 个时隙的起点
+
+    auto plan = hop_plan::make(bw_hop, ch_sep, 0, hop_rate);
+    BOOST_REQUIRE_EQUAL(plan->num_channels(), 4);
+
+    // 输入样点 n 所在的时隙，以及离最近的跳频边界的距离（输入样点）
+    double elapsed0 = frac_sec * fsa_hop;
+    auto slot_of = [&](double n) {
+        return first_slot + static_cast<uint64_t>((elapsed0 + n) / samples_per_hop);
+    };
+    auto boundary_distance = [&](double n) {
+        double pos = std::fmod(elapsed0 + n, samples_per_hop);
+        return std::min(pos, samples_per_hop - pos);
+    };
+
+    int num_samples = static_cast<int>(num_hops * samples_per_hop);
+    std::vector<gr_complex> in_data(num_samples);
+    std::vector<int> channels_seen;
+    double phase = 0;
+    for (int n = 0; n < num_samples; n++) {
+        int ch = plan->channel(slot_of(n));
+        if (std::find(channels_seen.begin(), channels_seen.end(), ch) ==
+            channels_seen.end()) {
+            channels_seen.push_back(ch);
+        }
+        in_data[n] = std::exp(gr_complex(0, static_cast<float>(phase)));
+        phase = std::fmod(phase + 2 * M_PI * plan->frequency(ch) / fsa_hop, 2 * M_PI);
+    }
+    // 信号确实在多个信道之间跳
+    BOOST_REQUIRE_GT(channels_seen.size(), 1u);
+
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = 0;
+    t.key = pmt::mp("rx_time");
+    t.value = pmt::make_tuple(pmt::from_uint64(sec), pmt::from_double(frac_sec));
+    tags.push_back(t);
+
+    // 端口 0 跟随发送端的图案；端口 1 偏移一个时隙，只有相邻两跳同信道时才有信号
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto chan = hop_channelizer::make(bw_hop, ch_sep, 0, fsa_hop, hop_rate, decim, { 0, 1 });
+    auto sink0 = blocks::vector_sink_c::make();
+    auto sink1 = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_hop_channelizer_multi_channel");
+    tb->connect(src, 0, chan, 0);
+    tb->connect(chan, 0, sink0, 0);
+    tb->connect(chan, 1, sink1, 0);
+    tb->run();
+
+    auto out0 = sink0->data();
+    auto out1 = sink1->data();
+    BOOST_REQUIRE_EQUAL(out0.size(), out1.size());
+    BOOST_REQUIRE_GT(out0.size(), static_cast<size_t>(num_samples / decim / 2));
+
+    // 只检查离跳频边界和数据起点足够远的样点，避开信道化器的时延和滤波暂态
+    const double margin = samples_per_hop / 8;
+    int checked = 0;
+    for (size_t m = 0; m < out0.size(); m++) {
+        double n = static_cast<double>(m) * decim;
+        if (n < margin || boundary_distance(n) < margin) {
+            continue;
+        }
+        uint64_t slot = slot_of(n);
+        BOOST_CHECK_SMALL(std::abs(out0[m]) - 1.0f, 5e-2f);
+        if (plan->channel(slot + 1) == plan->channel(slot)) {
+            BOOST_CHECK_SMALL(std::abs(out1[m]) - 1.0f, 5e-2f);
+        } else {
+            BOOST_CHECK_SMALL(std::abs(out1[m]), 1e-1f);
+        }
+        checked++;
+    }
+    BOOST_CHECK_GT(checked, num_hops * static_cast<int>(samples_per_hop / decim) / 2);
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
@@ -7,8 +7,16 @@
 
 #include <gnuradio/attributes.h>
 #include <gnuradio/freq_hopping/hop_demod.h>
+#include <gnuradio/freq_hopping/hop_mod.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/blocks/vector_to_stream.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace gr {
 namespace freq_hopping {
@@ -115,5 +123,279 @@ BOOST_AUTO_TEST_CASE(test_hop_demod_different_parameters)
     std::cout << "All parameter sets accepted successfully" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_hop_demod_segmented_mixing)
+{
+    std::cout << "\n=== Test 6: Segmented Mixing Across Hop Boundaries ===" << std::endl;
+
+    // 只有一个信道，频率恒为 freq_carrier，解跳后应为相位连续的直流
+    double bw_hop = 3e3;
+    double ch_sep = 3e3;
+    double freq_carrier = 1e3;
+    double fsa_hop = 48e3;
+    double hop_rate = 110; // 非整数的每跳样点数
+    int num_samples = 4096;
+
+    std::vector<gr_complex> in_data(num_samples);
+    for (int n = 0; n < num_samples; n++) {
+        in_data[n] = std::exp(gr_complex(0, 2 * M_PI * freq_carrier * n / fsa_hop));
+    }
+
+    // 在第一个样点打 rx_time 标签
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = 0;
+    t.key = pmt::mp("rx_time");
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.0123));
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto demod = hop_demod::make(bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_segmented_mixing");
+    tb->connect(src, 0, demod, 0);
+    tb->connect(demod, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), num_samples);
+
+    // 每个样点都应与第一个样点相同（跨越多个跳频边界）
+    for (int n = 0; n < num_samples; n++) {
+        BOOST_CHECK_SMALL(std::abs(out_data[n] - out_data[0]), 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_demod_decimated_output)
+{
+    std::cout << "\n=== Test 7: Decimated Output ===" << std::endl;
+
+    // 与 Test 6 相同的单信道信号，解跳后直接抽取 12 倍
+    double bw_hop = 3e3;
+    double ch_sep = 3e3;
+    double freq_carrier = 1e3;
+    double fsa_hop = 48e3;
+    double hop_rate = 110;
+    int decim = 12;
+    int num_samples = 12 * 1024;
+
+    std::vector<gr_complex> in_data(num_samples);
+    for (int n = 0; n < num_samples; n++) {
+        in_data[n] = std::exp(gr_complex(0, 2 * M_PI * freq_carrier * n / fsa_hop));
+    }
+
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = 0;
+    t.key = pmt::mp("rx_time");
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.0123));
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto demod =
+        hop_demod::make(bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate, false, decim);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_decimated_output");
+    tb->connect(src, 0, demod, 0);
+    tb->connect(demod, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), num_samples / decim);
+
+    // 跳过抽取滤波器的起始暂态后，输出为单位幅度的直流
+    const int skip = 128;
+    for (size_t n = skip; n < out_data.size(); n++) {
+        BOOST_CHECK_SMALL(std::abs(out_data[n] - out_data[skip]), 1e-2f);
+        BOOST_CHECK_SMALL(std::abs(out_data[n]) - 1.0f, 1e-2f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_demod_simulated_time_loopback)
+{
+    std::cout << "\n=== Test 8: Simulated Time Loopback ===" << std::endl;
+
+    // hop_mod 仿真时间模式直接接 hop_demod，不经过 USRP，也不受实时限制
+    double bw_hop = 30e3; // 10 个信道
+    double ch_sep = 3e3;
+    double fsa_hop = 12e3;
+    double hop_rate = 5;
+    int samples_per_hop = 2400;
+    int num_hops = 6;
+
+    std::vector<gr_complex> in_data(samples_per_hop * num_hops, gr_complex(1.0f, 0.0f));
+    auto src = blocks::vector_source_c::make(in_data, false, samples_per_hop);
+    auto mod = hop_mod::make(bw_hop,
+                             ch_sep,
+                             0,
+                             fsa_hop,
+                             hop_rate,
+                             samples_per_hop,
+                             false,
+                             time_source::SIMULATED,
+                             0,
+                             1000.3);
+    auto v2s = blocks::vector_to_stream::make(sizeof(gr_complex), samples_per_hop);
+    auto demod =
+        hop_demod::make(bw_hop, ch_sep, 0, fsa_hop, hop_rate, false, 1, true);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_simulated_time_loopback");
+    tb->connect(src, 0, mod, 0);
+    tb->connect(mod, 0, v2s, 0);
+    tb->connect(v2s, 0, demod, 0);
+    tb->connect(demod, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), in_data.size());
+
+    // 每跳内解跳后为单位幅度的直流（每跳最后 0.1 ms 提前切换到下一跳的频率）
+    for (int h = 0; h < num_hops; h++) {
+        const gr_complex* hop = &out_data[h * samples_per_hop];
+        for (int n = 0; n < samples_per_hop - 2; n++) {
+            BOOST_CHECK_SMALL(std::abs(hop[n] - hop[0]), 1e-3f);
+        }
+        BOOST_CHECK_SMALL(std::abs(hop[0]) - 1.0f, 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_demod_overflow_resync)
+{
+    std::cout << "\n=== Test 9: Re-anchoring After an Overflow Gap ===" << std::endl;
+
+    // 每跳 2400 个样点；第二个 rx_time 标签比推算时刻晚 1 s，相当于溢出丢了 5 跳
+    double fsa_hop = 12e3;
+    double hop_rate = 5;
+    int num_samples = 3000;
+
+    std::vector<gr_complex> in_data(num_samples, gr_complex(1.0f, 0.0f));
+
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.key = pmt::mp("rx_time");
+    t.offset = 0;
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.0));
+    tags.push_back(t);
+    t.offset = 1000;
+    t.value = pmt::make_tuple(pmt::from_uint64(1001), pmt::from_double(1000 / fsa_hop));
+    tags.push_back(t);
+    // 与上一个标签连续，只重新锚定
+    t.offset = 2000;
+    t.value = pmt::make_tuple(pmt::from_uint64(1001), pmt::from_double(2000 / fsa_hop));
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto demod = hop_demod::make(30e3, 3e3, 0, fsa_hop, hop_rate);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_overflow_resync");
+    tb->connect(src, 0, demod, 0);
+    tb->connect(demod, 0, sink, 0);
+    tb->run();
+
+    BOOST_CHECK_EQUAL(demod->discontinuities(), 1);
+    BOOST_CHECK_EQUAL(demod->lost_samples(), 12000);
+    BOOST_CHECK_EQUAL(demod->dropped_hops(), 5);
+
+    int gaps = 0;
+    for (const auto& tag : sink->tags()) {
+        if (!pmt::eq(tag.key, pmt::mp("dropped_hops"))) {
+            continue;
+        }
+        gaps++;
+        BOOST_CHECK_EQUAL(tag.offset, 1000);
+        BOOST_CHECK_EQUAL(
+            pmt::to_uint64(pmt::dict_ref(tag.value, pmt::mp("lost_samples"), pmt::PMT_NIL)),
+            12000);
+        BOOST_CHECK_EQUAL(
+            pmt::to_uint64(pmt::dict_ref(tag.value, pmt::mp("dropped_hops"), pmt::PMT_NIL)),
+            5);
+        BOOST_CHECK_EQUAL(
+            pmt::to_uint64(pmt::dict_ref(tag.value, pmt::mp("slot_idx"), pmt::PMT_NIL)),
+            5005);
+    }
+    BOOST_CHECK_EQUAL(gaps, 1);
+
+    // 丢失之后的样点按新时隙解跳，与直接从该时刻开始接收的结果一致
+    tag_t ref_tag = tags[1];
+    ref_tag.offset = 0;
+    auto ref_src = blocks::vector_source_c::make(
+        std::vector<gr_complex>(in_data.begin() + 1000, in_data.end()),
+        false,
+        1,
+        std::vector<tag_t>{ ref_tag });
+    auto ref_demod = hop_demod::make(30e3, 3e3, 0, fsa_hop, hop_rate);
+    auto ref_sink = blocks::vector_sink_c::make();
+    auto ref_tb = gr::make_top_block("test_overflow_resync_ref");
+    ref_tb->connect(ref_src, 0, ref_demod, 0);
+    ref_tb->connect(ref_demod, 0, ref_sink, 0);
+    ref_tb->run();
+
+    auto out_data = sink->data();
+    auto ref_data = ref_sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), num_samples);
+    BOOST_REQUIRE_EQUAL(ref_data.size(), num_samples - 1000);
+    // 旋转器相位在跳间连续，两者只差一个固定相位
+    gr_complex rot = ref_data[0] / out_data[1000];
+    for (int n = 0; n < num_samples - 1000; n++) {
+        BOOST_CHECK_SMALL(std::abs(out_data[1000 + n] * rot - ref_data[n]), 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_demod_hop_start_tags)
+{
+    std::cout << "\n=== Test 10: Hop Boundary Tags ===" << std::endl;
+
+    // 每跳 2400 个样点，从时隙起点开始接收；提前 0.1 ms（1.2 个样点）切换，
+    // 边界在 2399、4799、7199
+    double fsa_hop = 12e3;
+    double hop_rate = 5;
+    int num_samples = 8000;
+
+    std::vector<gr_complex> in_data(num_samples, gr_complex(1.0f, 0.0f));
+
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.key = pmt::mp("rx_time");
+    t.offset = 0;
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.0));
+    tags.push_back(t);
+    // 跳内连续的时间标签只重新锚定，不产生边界
+    t.offset = 3000;
+    t.value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.25));
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto demod = hop_demod::make(30e3, 3e3, 0, fsa_hop, hop_rate, false, 1, false, true);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_hop_start_tags");
+    tb->connect(src, 0, demod, 0);
+    tb->connect(demod, 0, sink, 0);
+    tb->run();
+
+    auto plan = hop_plan::make(30e3, 3e3, 0, hop_rate);
+    std::vector<uint64_t> expected_offsets = { 2399, 4799, 7199 };
+    std::vector<tag_t> hop_tags;
+    for (const auto& tag : sink->tags()) {
+        if (pmt::eq(tag.key, pmt::mp("hop_start"))) {
+            hop_tags.push_back(tag);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(hop_tags.size(), expected_offsets.size());
+    for (size_t i = 0; i < hop_tags.size(); i++) {
+        uint64_t slot = 5001 + i;
+        BOOST_CHECK_EQUAL(hop_tags[i].offset, expected_offsets[i]);
+        BOOST_CHECK_EQUAL(pmt::to_uint64(pmt::dict_ref(
+                              hop_tags[i].value, pmt::mp("slot_idx"), pmt::PMT_NIL)),
+                          slot);
+        BOOST_CHECK_EQUAL(pmt::to_long(pmt::dict_ref(
+                              hop_tags[i].value, pmt::mp("channel"), pmt::PMT_NIL)),
+                          plan->channel(slot));
+    }
+}
+
 } /* namespace freq_hopping */
-} /* namespace gr */
\ No newline at end of file
+} /* namespace gr */
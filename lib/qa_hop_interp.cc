@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/freq_hopping/hop_interp.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include "cascade_resampler.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_cascade_interpolator_tone)
+{
+    std::cout << "=== Test 1: Cascade Interpolator ===" << std::endl;
+
+    // 256 = 2^8，3 为单级奇数倍，12 = 3 * 2^2
+    for (int interp : { 256, 3, 12 }) {
+        cascade_interpolator interpolator(interp);
+        int n = 400;
+        float f = 0.05f;
+        std::vector<gr_complex> in(n), out(n * interp);
+        for (int i = 0; i < n; i++) {
+            in[i] = std::exp(gr_complex(0, 2 * M_PI * f * i));
+        }
+
+        // 分两次调用，滤波器状态应连续
+        interpolator.execute(in.data(), n / 2, out.data());
+        interpolator.execute(in.data() + n / 2, n / 2, out.data() + n / 2 * interp);
+
+        // 跳过起始暂态后，输出为单位幅度、频率为 f/interp 的单音
+        for (int i = n * interp / 4; i < n * interp - 1; i++) {
+            BOOST_CHECK_SMALL(std::abs(out[i]) - 1.0f, 2e-2f);
+            float dphi = std::arg(out[i + 1] * std::conj(out[i]));
+            BOOST_CHECK_SMALL(dphi - float(2 * M_PI * f / interp), 1e-3f);
+        }
+        std::cout << "interp " << interp << ": " << interpolator.num_stages()
+                  << " stages" << std::endl;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_interp_vector)
+{
+    std::cout << "\n=== Test 2: hop_interp Vector Output ===" << std::endl;
+
+    int interp_fac = 16;
+    int vlen = 64;
+    int num_frames = 3;
+
+    std::vector<gr_complex> in_data(vlen * num_frames, gr_complex(1.0f, 0.0f));
+    auto src = blocks::vector_source_c::make(in_data, false, vlen);
+    auto interp = hop_interp::make(interp_fac, vlen);
+    auto sink = blocks::vector_sink_c::make(vlen * interp_fac);
+
+    auto tb = gr::make_top_block("test_hop_interp");
+    tb->connect(src, 0, interp, 0);
+    tb->connect(interp, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE_EQUAL(out_data.size(), num_frames * vlen * interp_fac);
+
+    // 每跳重新开始，后半跳为直流 1
+    for (int k = 0; k < num_frames; k++) {
+        for (int i = vlen * interp_fac / 2; i < vlen * interp_fac; i++) {
+            BOOST_CHECK_SMALL(std::abs(out_data[k * vlen * interp_fac + i] - gr_complex(1, 0)),
+                              1e-2f);
+        }
+    }
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
@@ -11,6 +11,7 @@
 
 #include <gnuradio/attributes.h>
 #include <gnuradio/freq_hopping/hop_mod.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
 #include <gnuradio/blocks/vector_sink.h>
 #include <gnuradio/blocks/vector_source.h>
 #include <gnuradio/blocks/head.h>
@@ -20,10 +21,26 @@
 #include <vector>
 #include <complex>
 #include <cmath>
+#include "phasor_table.h"
 
 namespace gr {
 namespace freq_hopping {
 
+namespace {
+
+// 固定时刻的外部实时时钟，类型保留默认的 HOST
+class fixed_time_source : public time_source
+{
+private:
+    uint64_t d_now_ns;
+
+public:
+    explicit fixed_time_source(uint64_t now_ns) : d_now_ns(now_ns) {}
+    uint64_t now_ns() override { return d_now_ns; }
+};
+
+} // namespace
+
 BOOST_AUTO_TEST_CASE(test_hop_mod_basic)
 {
     // 测试参数
@@ -251,5 +268,106 @@ BOOST_AUTO_TEST_CASE(test_hop_mod_frame_consistency)
     std::cout << "Frame consistency test: processed " << num_frames << " frames, output " << output_data.size() << " samples" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_hop_mod_phasor_table)
+{
+    // 测试相量表混频与直接计算的复指数一致（跨越多张表的长度）
+    std::vector<double> freqs = { -6e3, 0.0, 3e3, 497e3 };
+    double fs = 2.4576e6;
+    int table_len = 256;
+    int n = 1000;
+
+    phasor_table table(freqs, fs, 1, table_len);
+    std::vector<gr_complex> in(n, gr_complex(1.0f, 0.0f));
+    std::vector<gr_complex> out(n);
+
+    for (size_t ch = 0; ch < freqs.size(); ch++) {
+        table.mix(ch, in.data(), out.data(), n);
+        for (int k = 0; k < n; k++) {
+            gr_complex expected = std::exp(gr_complex(0, 2 * M_PI * freqs[ch] * k / fs));
+            BOOST_CHECK_SMALL(std::abs(out[k] - expected), 1e-4f);
+        }
+    }
+
+    // 块的输出长度与 NCO 模式相同
+    int vlen = 4096;
+    int num_frames = 2;
+    std::vector<gr_complex> test_data(vlen * num_frames, gr_complex(1.0f, 0.0f));
+    auto hop_mod_block = hop_mod::make(1e6, 3e3, 500e3, fs, 20, vlen, true);
+    auto source = gr::blocks::vector_source_c::make(test_data, false, vlen);
+    auto sink = gr::blocks::vector_sink_c::make(vlen, 1024);
+
+    auto tb = gr::make_top_block("test_phasor_table");
+    tb->connect(source, 0, hop_mod_block, 0);
+    tb->connect(hop_mod_block, 0, sink, 0);
+    tb->run();
+
+    BOOST_CHECK_EQUAL(sink->data().size(), num_frames * vlen);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_mod_simulated_clock)
+{
+    // 虚拟时钟下第一跳的 tx_time 只由时钟和参数决定：5 跳/秒，时隙 200 ms
+    const int vlen = 100;
+    std::vector<gr_complex> test_data(vlen * 4, gr_complex(1.0f, 0.0f));
+
+    auto run = [&](hop_mod::sptr blk) {
+        auto source = gr::blocks::vector_source_c::make(test_data, false, vlen);
+        auto sink = gr::blocks::vector_sink_c::make(vlen, 1024);
+        auto tb = gr::make_top_block("test_simulated_clock");
+        tb->connect(source, 0, blk, 0);
+        tb->connect(blk, 0, sink, 0);
+        tb->run();
+
+        BOOST_CHECK_EQUAL(sink->data().size(), test_data.size());
+        auto tags = sink->tags();
+        BOOST_REQUIRE_EQUAL(tags.size(), 1u);
+        BOOST_CHECK_EQUAL(tags[0].offset, 0u);
+        return hop_plan::to_ns(pmt::to_uint64(pmt::tuple_ref(tags[0].value, 0)),
+                               pmt::to_double(pmt::tuple_ref(tags[0].value, 1)));
+    };
+
+    // 仿真时间没有处理延迟：第一跳就是 epoch 之后的第一个时隙边界
+    auto blk = hop_mod::make(12000, 3000, 0, 12000, 5, vlen, false, time_source::SIMULATED);
+    BOOST_CHECK_EQUAL(run(blk), 0u);
+    blk = hop_mod::make(
+        12000, 3000, 0, 12000, 5, vlen, false, time_source::SIMULATED, 0, 100.05);
+    BOOST_CHECK_EQUAL(run(blk), 100200000000ULL);
+
+    // 额外提前 1 s
+    blk = hop_mod::make(12000, 3000, 0, 12000, 5, vlen, false, time_source::SIMULATED, 1.0);
+    BOOST_CHECK_EQUAL(run(blk), 1000000000ULL);
+
+    // 虚拟时钟随输出样点推进：4 个向量共 400 个样点，12 kHz 下为 1/30 s
+    auto sim = time_source::make_simulated(0);
+    blk = hop_mod::make(12000, 3000, 0, 12000, 5, vlen, false, time_source::SIMULATED, 1.0);
+    blk->set_time_source(sim);
+    BOOST_CHECK_EQUAL(run(blk), 1000000000ULL);
+    BOOST_CHECK_EQUAL(sim->now_ns(), 1000000000ULL + 33333333ULL);
+
+    // 主机模式下外部给定的时钟：10:00:00.35 之后第一跳位于 10:00:00.6
+    uint64_t day_ns = 19000ULL * hop_plan::NS_PER_DAY;
+    blk = hop_mod::make(12000, 3000, 0, 12000, 5, vlen);
+    blk->set_time_source(std::make_shared<fixed_time_source>(day_ns + 36000350000000ULL));
+    BOOST_CHECK_EQUAL(run(blk), day_ns + 36000600000000ULL);
+
+    // 换上虚拟时钟后按仿真时间对齐，与构造时的 clock 参数无关
+    sim = time_source::make_simulated(day_ns + 36000350000000ULL);
+    BOOST_CHECK_EQUAL(sim->type(), time_source::SIMULATED);
+    blk = hop_mod::make(12000, 3000, 0, 12000, 5, vlen);
+    blk->set_time_source(sim);
+    BOOST_CHECK_EQUAL(run(blk), day_ns + 36000400000000ULL);
+    BOOST_CHECK_EQUAL(sim->now_ns(), day_ns + 36000400000000ULL + 33333333ULL);
+
+    // 设备时钟在收到时间之前无效
+    auto device = time_source::make_device();
+    BOOST_CHECK(!device->valid());
+    device->set_time(day_ns);
+    BOOST_CHECK(device->valid());
+    BOOST_CHECK(device->now_ns() >= day_ns);
+
+    BOOST_CHECK_THROW(hop_mod::make(12000, 3000, 0, 12000, 5, vlen, false, 3),
+                      std::invalid_argument);
+}
+
 } /* namespace freq_hopping */
-} /* namespace gr */
\ No newline at end of file
+} /* namespace gr */
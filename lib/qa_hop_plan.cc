@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+
+#include "hop_sequence.h"
+#include "phasor_table.h"
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_hop_plan_shared_instance)
+{
+    // 相同参数返回同一个对象，参数不同则是新的对象
+    auto plan = hop_plan::make(1e6, 3e3, 0, 110);
+    auto same = hop_plan::make(1e6, 3e3, 0, 110);
+    auto other = hop_plan::make(1e6, 3e3, 0, 110, hop_plan::DEFAULT_KEY + 1);
+    BOOST_CHECK(plan == same);
+    BOOST_CHECK(plan != other);
+
+    // 110 跳/秒按 9600/87 处理
+    BOOST_CHECK_CLOSE(plan->hop_rate(), 9600.0 / 87, 1e-9);
+    BOOST_CHECK_EQUAL(plan->slot_ns(), static_cast<uint64_t>(87.0 / 9600 * 1e9));
+
+    // 频率表和跳频图案与原来各块内的计算一致
+    BOOST_REQUIRE_EQUAL(plan->num_channels(), 333);
+    BOOST_CHECK_CLOSE(plan->frequency(0), -166 * 3e3, 1e-9);
+    BOOST_CHECK_SMALL(plan->frequency(166), 1e-9);
+    hop_sequence seq(333);
+    for (uint64_t s = 0; s < 1000; ++s) {
+        BOOST_CHECK_EQUAL(plan->channel(s), seq.channel(s));
+    }
+
+    // 相量表同样只计算一次
+    auto t0 = plan->mixer_table(2457600, -1, 0);
+    auto t1 = same->mixer_table(2457600, -1, 0);
+    BOOST_CHECK(t0 == t1);
+    BOOST_CHECK_EQUAL(t0->num_channels(), 333);
+
+    BOOST_CHECK_THROW(hop_plan::make(0, 3e3, 0, 5), std::invalid_argument);
+    BOOST_CHECK_THROW(hop_plan::make(1e6, 3e3, 0, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_plan_slot_arithmetic)
+{
+    auto plan = hop_plan::make(12000, 3000, 0, 5);
+    const uint64_t slot_ns = plan->slot_ns();
+    BOOST_REQUIRE_EQUAL(slot_ns, 200000000ULL);
+
+    // 某天 10:00:00.35，位于当天第 180001 个时隙的 150 ms 处
+    uint64_t day = 19000ULL * 24 * 3600;
+    uint64_t t = hop_plan::to_ns(day + 36000, 0.35);
+    BOOST_CHECK_EQUAL(hop_plan::ns_since_midnight(t), 36000350000000ULL);
+    BOOST_CHECK_EQUAL(plan->slot_index(t), 180001u);
+    BOOST_CHECK_EQUAL(plan->slot_offset_ns(t), 150000000u);
+
+    // 发送端至少留出一个完整时隙
+    uint64_t tx_slot = plan->first_tx_slot(t);
+    BOOST_CHECK_EQUAL(tx_slot, 180003u);
+    BOOST_CHECK_EQUAL(plan->slot_start_ns(t, tx_slot),
+                      day * 1000000000ULL + tx_slot * slot_ns);
+
+    // 接收端用发送时刻得到同一个时隙号
+    BOOST_CHECK_EQUAL(plan->slot_index(plan->slot_start_ns(t, tx_slot)), tx_slot);
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
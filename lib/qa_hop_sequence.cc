@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/attributes.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "hop_sequence.h"
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_hop_sequence_philox_known_answer)
+{
+    // Random123 的 Philox4x32-10 已知答案：计数器和密钥全零时第一个输出字
+    BOOST_CHECK_EQUAL(hop_sequence::philox(0, 0), 0x6627e8d5u);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_sequence_channels)
+{
+    const int num_ch = 333;
+    hop_sequence seq(num_ch);
+    hop_sequence same(num_ch);
+    hop_sequence other_key(num_ch, hop_plan::DEFAULT_KEY + 1);
+
+    std::vector<int> hist(num_ch, 0);
+    int n_diff_key = 0;
+    int n_period_match = 0;
+    const uint64_t n_slots = 100000;
+    for (uint64_t s = 0; s < n_slots; ++s) {
+        int ch = seq.channel(s);
+        BOOST_REQUIRE(ch >= 0 && ch < num_ch);
+        hist[ch]++;
+
+        // 同样的信道数和密钥逐位一致，任意时隙可直接求出
+        BOOST_CHECK_EQUAL(ch, same.channel(s));
+        n_diff_key += (ch != other_key.channel(s));
+
+        // 不再以 2*num_ch 为周期重复
+        n_period_match += (ch == seq.channel(s + 2 * num_ch));
+    }
+
+    // 每个信道的出现次数接近 n_slots / num_ch ≈ 300
+    for (int v : hist) {
+        BOOST_CHECK(v > 200 && v < 400);
+    }
+    BOOST_CHECK(n_diff_key > (int)(n_slots * 9 / 10));
+    BOOST_CHECK(n_period_match < (int)(n_slots / 100));
+
+    // 远处的时隙同样 O(1) 可得
+    BOOST_CHECK_EQUAL(seq.channel(0xFFFFFFFFFFFFull), same.channel(0xFFFFFFFFFFFFull));
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
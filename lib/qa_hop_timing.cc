@@ -0,0 +1,81 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/attributes.h>
+#include <boost/test/unit_test.hpp>
+
+#include "hop_timing.h"
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_hop_timing_rational)
+{
+    uint64_t num, den;
+    approximate_rational(2457600, 1000000, num, den);
+    BOOST_CHECK_EQUAL(num, 2457600u);
+    BOOST_CHECK_EQUAL(den, 1u);
+    approximate_rational(9600.0 / 87, 1000000, num, den);
+    BOOST_CHECK_EQUAL(num, 3200u);
+    BOOST_CHECK_EQUAL(den, 29u);
+    approximate_rational(1.0 / 3, 1000000, num, den);
+    BOOST_CHECK_EQUAL(num, 1u);
+    BOOST_CHECK_EQUAL(den, 3u);
+
+    // 110 跳/秒的时隙换算按 87/9600 s 精确进行
+    auto plan = hop_plan::make(12000, 3000, 0, 110);
+    BOOST_CHECK_EQUAL(plan->rate_num(), 3200u);
+    BOOST_CHECK_EQUAL(plan->rate_den(), 29u);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_timing_exact_boundaries)
+{
+    // 3 跳/秒、1 MHz：每跳 333333.33 个样点，纳秒时隙长度也不是整数。
+    // 一整天之后的跳频边界仍然精确等于 ceil(h * 10^6 / 3)
+    auto plan = hop_plan::make(12000, 3000, 0, 3);
+    hop_timing timing(plan, 1e6, 1);
+    uint64_t day_ns = 19000ULL * hop_plan::NS_PER_DAY;
+    timing.anchor(0, day_ns, 0);
+    BOOST_CHECK_EQUAL(timing.ref_slot(), 0u);
+
+    for (uint64_t h = 1; h < 259200; h += 997) {
+        uint64_t start = (h * 1000000ULL + 2) / 3;
+        BOOST_CHECK_EQUAL(timing.hop_start(h), start);
+        BOOST_CHECK_EQUAL(timing.hop_of(start), h);
+        BOOST_CHECK_EQUAL(timing.hop_of(start - 1), h - 1);
+    }
+
+    // 当天最后一纳秒仍在第 259199 个时隙
+    BOOST_CHECK_EQUAL(plan->slot_index(day_ns + hop_plan::NS_PER_DAY - 1), 259199u);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_timing_anchor)
+{
+    // 5 跳/秒、12 kHz、抽取 4：每跳 600 个输出样点
+    auto plan = hop_plan::make(12000, 3000, 0, 5);
+    hop_timing timing(plan, 12000, 4);
+    BOOST_CHECK_CLOSE(timing.samples_per_hop(), 600.0, 1e-12);
+
+    // 输入样点 1002 处为第 7 个时隙的 50 ms 处，锚点为输出样点 251，
+    // 比标签晚 2 个输入样点：已进入时隙 150 + 0.5 个输出样点
+    uint64_t t = 19000ULL * hop_plan::NS_PER_DAY + 7 * 200000000ULL + 50000000ULL;
+    timing.anchor(1002, t, 0);
+    BOOST_CHECK_EQUAL(timing.ref_slot(), 7u);
+    BOOST_CHECK_EQUAL(timing.anchor_output(), 251u);
+    BOOST_CHECK_EQUAL(timing.hop_of(251), 0u);
+    BOOST_CHECK_EQUAL(timing.hop_start(1), 251u + 450u);
+    BOOST_CHECK_EQUAL(timing.hop_of(700), 0u);
+    BOOST_CHECK_EQUAL(timing.hop_of(701), 1u);
+    BOOST_CHECK_EQUAL(timing.hop_start(1000), 251u + 450u + 999u * 600u);
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
@@ -0,0 +1,180 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/freq_hopping/bb_pskmod.h>
+#include <gnuradio/freq_hopping/hop_interp.h>
+#include <gnuradio/freq_hopping/hop_mod.h>
+#include <gnuradio/freq_hopping/hop_plan.h>
+#include <gnuradio/freq_hopping/hop_tx.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include "bb_pskmod_impl.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+
+// 固定时刻的外部实时时钟，类型保留默认的 HOST
+class fixed_time_source : public time_source
+{
+private:
+    uint64_t d_now_ns;
+
+public:
+    explicit fixed_time_source(uint64_t now_ns) : d_now_ns(now_ns) {}
+    uint64_t now_ns() override { return d_now_ns; }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_hop_tx_matches_chain)
+{
+    std::cout << "=== Test 1: hop_tx vs bb_pskmod -> hop_interp -> hop_mod ===" << std::endl;
+
+    // 只有一个信道，两条链路的频率相同，输出应逐点一致
+    int hop_rate = 20;
+    int M_order = 4;
+    int Ksa_ch = 4;
+    int interp_fac = 16;
+    double bw_hop = 3e3;
+    double ch_sep = 3e3;
+    double freq_carrier = 20e3;
+    double fsa_hop = 2400.0 * Ksa_ch * interp_fac;
+    int num_frames = 4;
+
+    int input_length = bb_pskmod_impl::calculate_input_length(hop_rate);
+    int bb_length = bb_pskmod_impl::calculate_output_length(hop_rate, Ksa_ch);
+    int output_length = bb_length * interp_fac;
+
+    std::vector<int> test_data(input_length * num_frames);
+    for (size_t i = 0; i < test_data.size(); i++) {
+        test_data[i] = (i * 7 + i / 3) % M_order;
+    }
+
+    // 分立模块链路
+    auto src0 = blocks::vector_source_i::make(test_data, false, input_length);
+    auto pskmod = bb_pskmod::make(hop_rate, M_order, Ksa_ch);
+    auto interp = hop_interp::make(interp_fac, bb_length);
+    auto mod = hop_mod::make(bw_hop, ch_sep, freq_carrier, fsa_hop, hop_rate, output_length);
+    auto sink0 = blocks::vector_sink_c::make(output_length);
+
+    // 融合模块
+    auto src1 = blocks::vector_source_i::make(test_data, false, input_length);
+    auto tx = hop_tx::make(
+        hop_rate, M_order, Ksa_ch, interp_fac, bw_hop, ch_sep, freq_carrier, fsa_hop);
+    auto sink1 = blocks::vector_sink_c::make(output_length);
+
+    auto tb = gr::make_top_block("test_hop_tx");
+    tb->connect(src0, 0, pskmod, 0);
+    tb->connect(pskmod, 0, interp, 0);
+    tb->connect(interp, 0, mod, 0);
+    tb->connect(mod, 0, sink0, 0);
+    tb->connect(src1, 0, tx, 0);
+    tb->connect(tx, 0, sink1, 0);
+    tb->run();
+
+    auto chain_out = sink0->data();
+    auto fused_out = sink1->data();
+    BOOST_REQUIRE_EQUAL(chain_out.size(), num_frames * output_length);
+    BOOST_REQUIRE_EQUAL(fused_out.size(), chain_out.size());
+
+    for (size_t i = 0; i < fused_out.size(); i++) {
+        BOOST_CHECK_SMALL(std::abs(fused_out[i] - chain_out[i]), 1e-4f);
+    }
+
+    // 第一跳带 tx_time 标签
+    auto tags = sink1->tags();
+    BOOST_REQUIRE_EQUAL(tags.size(), 1u);
+    BOOST_CHECK_EQUAL(tags[0].offset, 0u);
+    BOOST_CHECK_EQUAL(pmt::symbol_to_string(tags[0].key), "tx_time");
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_tx_parameter_validation)
+{
+    std::cout << "\n=== Test 2: Parameter Validation ===" << std::endl;
+
+    BOOST_CHECK_NO_THROW(hop_tx::make());
+    BOOST_CHECK_THROW(hop_tx::make(20, 3), std::invalid_argument);
+    BOOST_CHECK_THROW(hop_tx::make(20, 4, 4, 0), std::invalid_argument);
+    BOOST_CHECK_THROW(hop_tx::make(20, 4, 4, 256, 1e6, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_hop_tx_time_source)
+{
+    std::cout << "\n=== Test 3: Pluggable Time Source ===" << std::endl;
+
+    // 与 hop_mod 相同的对齐：5 跳/秒，时隙 200 ms，至少留一个完整时隙
+    int hop_rate = 5;
+    int input_length = bb_pskmod_impl::calculate_input_length(hop_rate);
+    int output_length = bb_pskmod_impl::calculate_output_length(hop_rate, 4) * 16;
+    std::vector<int> test_data(input_length * 2, 0);
+
+    auto run = [&](hop_tx::sptr blk) {
+        auto src = blocks::vector_source_i::make(test_data, false, input_length);
+        auto sink = blocks::vector_sink_c::make(output_length);
+        auto tb = gr::make_top_block("test_hop_tx_time_source");
+        tb->connect(src, 0, blk, 0);
+        tb->connect(blk, 0, sink, 0);
+        tb->run();
+
+        BOOST_CHECK_EQUAL(sink->data().size(), 2u * output_length);
+        auto tags = sink->tags();
+        BOOST_REQUIRE_EQUAL(tags.size(), 1u);
+        BOOST_CHECK_EQUAL(tags[0].offset, 0u);
+        return hop_plan::to_ns(pmt::to_uint64(pmt::tuple_ref(tags[0].value, 0)),
+                               pmt::to_double(pmt::tuple_ref(tags[0].value, 1)));
+    };
+
+    // 外部给定的时钟：10:00:00.35 之后第一跳位于 10:00:00.6，再提前 1 s 则位于 10:00:01.6
+    uint64_t day_ns = 19000ULL * hop_plan::NS_PER_DAY;
+    auto blk = hop_tx::make(hop_rate, 4, 4, 16, 3e3, 3e3, 20e3, 2400.0 * 4 * 16);
+    blk->set_time_source(std::make_shared<fixed_time_source>(day_ns + 36000350000000ULL));
+    BOOST_CHECK_EQUAL(run(blk), day_ns + 36000600000000ULL);
+
+    blk = hop_tx::make(
+        hop_rate, 4, 4, 16, 3e3, 3e3, 20e3, 2400.0 * 4 * 16, time_source::HOST, 1.0);
+    blk->set_time_source(std::make_shared<fixed_time_source>(day_ns + 36000350000000ULL));
+    BOOST_CHECK_EQUAL(run(blk), day_ns + 36001600000000ULL);
+
+    // 换上虚拟时钟后按仿真时间对齐，与构造时的 clock 参数无关
+    blk = hop_tx::make(hop_rate, 4, 4, 16, 3e3, 3e3, 20e3, 2400.0 * 4 * 16);
+    blk->set_time_source(time_source::make_simulated(day_ns + 36000350000000ULL));
+    BOOST_CHECK_EQUAL(run(blk), day_ns + 36000400000000ULL);
+
+    // 仿真时间：第一跳为 epoch 之后的第一个时隙边界，不留处理余量
+    double fsa_hop = 2400.0 * 4 * 16;
+    blk = hop_tx::make(
+        hop_rate, 4, 4, 16, 3e3, 3e3, 20e3, fsa_hop, time_source::SIMULATED, 0, 100.05);
+    BOOST_CHECK_EQUAL(run(blk), 100200000000ULL);
+
+    // 虚拟时钟随输出样点推进两跳
+    auto sim = time_source::make_simulated(0);
+    blk = hop_tx::make(
+        hop_rate, 4, 4, 16, 3e3, 3e3, 20e3, fsa_hop, time_source::SIMULATED, 1.0);
+    blk->set_time_source(sim);
+    BOOST_CHECK_EQUAL(run(blk), 1000000000ULL);
+    BOOST_CHECK_EQUAL(sim->now_ns(),
+                      1000000000ULL +
+                          static_cast<uint64_t>(2.0 * output_length / fsa_hop * 1e9));
+
+    BOOST_CHECK_THROW(hop_tx::make(20, 4, 4, 256, 1e6, 3e3, 500e3, 2457600, 3),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(hop_tx::make(20, 4, 4, 256, 1e6, 3e3, 500e3, 2457600, 0, -1.0),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(hop_tx::make(20, 4, 4, 256, 1e6, 3e3, 500e3, 2457600, 2, 0, -1.0),
+                      std::invalid_argument);
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
@@ -0,0 +1,158 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/attributes.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <gnuradio/freq_hopping/ser_measurement.h>
+
+namespace gr {
+namespace freq_hopping {
+
+BOOST_AUTO_TEST_CASE(test_ser_measurement_average)
+{
+    // 参考帧：64 个符号，取值 0~3
+    const int frame_len = 64;
+    std::vector<char> ref(frame_len);
+    for (int k = 0; k < frame_len; ++k) {
+        ref[k] = (char)((k * 7 + 3) % 4);
+    }
+    const std::string filename = "qa_ser_measurement_ref.bin";
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f.write(ref.data(), ref.size());
+    }
+
+    // 三帧，分别有 4、8、16 个错误（错误位置跨越 8 字节分组的边界）
+    const int n_err[] = { 4, 8, 16 };
+    std::vector<char> in_data;
+    std::vector<tag_t> tags;
+    for (int f = 0; f < 3; ++f) {
+        tag_t t;
+        t.offset = in_data.size();
+        t.key = pmt::mp("phase_est");
+        t.value = pmt::from_double(0.0);
+        tags.push_back(t);
+
+        std::vector<char> frame = ref;
+        for (int e = 0; e < n_err[f]; ++e) {
+            int pos = (e * 13 + f) % frame_len;
+            frame[pos] = (char)((frame[pos] + 1) % 4);
+        }
+        in_data.insert(in_data.end(), frame.begin(), frame.end());
+    }
+    // 结束标签，触发最后一次输出
+    tag_t t_end;
+    t_end.offset = in_data.size();
+    t_end.key = pmt::mp("phase_est");
+    t_end.value = pmt::from_double(0.0);
+    tags.push_back(t_end);
+    in_data.insert(in_data.end(), ref.begin(), ref.end());
+
+    auto src = blocks::vector_source_b::make(
+        std::vector<unsigned char>(in_data.begin(), in_data.end()), false, 1, tags);
+    auto ser = ser_measurement::make(filename);
+    auto sink = blocks::vector_sink_f::make();
+
+    auto tb = gr::make_top_block("test_ser_measurement");
+    tb->connect(src, 0, ser, 0);
+    tb->connect(ser, 0, sink, 0);
+    tb->run();
+    std::remove(filename.c_str());
+
+    // 每个新帧开始时输出之前各帧的平均SER：第一次为第 1 帧本身，
+    // 之后为历史窗口的平均
+    auto out = sink->data();
+    BOOST_REQUIRE_EQUAL(out.size(), 3);
+    BOOST_CHECK_CLOSE(out[0], 4.0f / 64, 1e-4);
+    BOOST_CHECK_CLOSE(out[1], 4.0f / 64, 1e-4);
+    BOOST_CHECK_CLOSE(out[2], (4.0f / 64 + 8.0f / 64) / 2, 1e-4);
+
+    // 统计快照：4 个标签，3 帧已结束（最后一帧还在接收）
+    BOOST_CHECK_EQUAL(ser->total_frames(), 4u);
+    BOOST_CHECK_EQUAL(ser->total_symbols(), 3u * frame_len);
+    BOOST_CHECK_EQUAL(ser->total_errors(), 4u + 8u + 16u);
+    BOOST_CHECK_EQUAL(ser->short_frames(), 0u);
+    BOOST_CHECK_EQUAL(ser->overlong_frames(), 0u);
+    BOOST_CHECK_CLOSE(ser->average_ser(), (4.0 + 8.0 + 16.0) / 64 / 3, 1e-6);
+    std::vector<uint64_t> expected_hist = { 0, 0, 0, 0, 1, 2 };
+    auto hist = ser->ser_histogram();
+    BOOST_CHECK_EQUAL_COLLECTIONS(hist.begin(), hist.end(), expected_hist.begin(), expected_hist.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_ser_measurement_multi_frame_reference)
+{
+    // 参考文件包含 3 个不同的帧，每帧 32 个符号
+    const int frame_len = 32;
+    const int n_frames = 3;
+    std::vector<char> ref(frame_len * n_frames);
+    for (size_t k = 0; k < ref.size(); ++k) {
+        ref[k] = (char)((k * 5 + k / frame_len) % 4);
+    }
+    const std::string filename = "qa_ser_measurement_multi_ref.bin";
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f.write(ref.data(), ref.size());
+    }
+
+    // 发送顺序：参考帧 0、1（按计数器），然后用 frame_num 标签指定参考帧 2、0
+    const int order[] = { 0, 1, 2, 0 };
+    std::vector<char> in_data;
+    std::vector<tag_t> tags;
+    for (int f = 0; f < 4; ++f) {
+        tag_t t;
+        t.offset = in_data.size();
+        t.key = pmt::mp("phase_est");
+        t.value = pmt::from_double(0.0);
+        tags.push_back(t);
+        if (f >= 2) {
+            t.key = pmt::mp("frame_num");
+            t.value = pmt::from_uint64(order[f]);
+            tags.push_back(t);
+        }
+        in_data.insert(in_data.end(),
+                       ref.begin() + order[f] * frame_len,
+                       ref.begin() + (order[f] + 1) * frame_len);
+    }
+    tag_t t_end;
+    t_end.offset = in_data.size();
+    t_end.key = pmt::mp("phase_est");
+    t_end.value = pmt::from_double(0.0);
+    tags.push_back(t_end);
+    in_data.insert(in_data.end(), ref.begin(), ref.begin() + frame_len);
+
+    auto src = blocks::vector_source_b::make(
+        std::vector<unsigned char>(in_data.begin(), in_data.end()), false, 1, tags);
+    auto ser = ser_measurement::make(filename, frame_len);
+    auto sink = blocks::vector_sink_f::make();
+
+    auto tb = gr::make_top_block("test_ser_measurement_multi");
+    tb->connect(src, 0, ser, 0);
+    tb->connect(ser, 0, sink, 0);
+    tb->run();
+    std::remove(filename.c_str());
+
+    // 每帧都和正确的参考帧比较，SER 全为 0
+    auto out = sink->data();
+    BOOST_REQUIRE_EQUAL(out.size(), 4);
+    for (float v : out) {
+        BOOST_CHECK_EQUAL(v, 0.0f);
+    }
+}
+
+} /* namespace freq_hopping */
+} /* namespace gr */
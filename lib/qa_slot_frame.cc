@@ -13,6 +13,7 @@
 #include <gnuradio/attributes.h>
 #include <gnuradio/freq_hopping/slot_frame.h>
 #include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
 #include <gnuradio/top_block.h>
 #include <boost/test/unit_test.hpp>
 #include <iostream>
@@ -123,5 +124,101 @@ BOOST_AUTO_TEST_CASE(test_slot_frame_value_range)
     std::cout << "All " << data.size() << " values are in range [0, " << (M_order-1) << "]" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_slot_frame_identical_frames)
+{
+    // 帧模板批量复制：每一帧都应与第一帧相同
+    int hop_rate = 110;
+    int M_order = 4;
+    int info_seed = 12345;
+    int num_frames = 1000;
+
+    int expected_length = slot_frame_impl::cal_vector_len(FSY_CH_HOP, hop_rate);
+    auto block = slot_frame::make(hop_rate, M_order, info_seed);
+    auto head = gr::blocks::head::make(sizeof(int) * expected_length, num_frames);
+    auto sink = gr::blocks::vector_sink_i::make(expected_length, 1024);
+    auto tb = gr::make_top_block("test_identical");
+    tb->connect(block, 0, head, 0);
+    tb->connect(head, 0, sink, 0);
+    tb->run();
+
+    auto data = sink->data();
+    BOOST_REQUIRE_EQUAL(data.size(), num_frames * expected_length);
+
+    for (size_t i = expected_length; i < data.size(); i++) {
+        BOOST_REQUIRE_EQUAL(data[i], data[i % expected_length]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_slot_frame_payload_input)
+{
+    // 负载输入：字节 0x1B = 00 01 10 11，QPSK 符号依次为 0,1,2,3
+    int hop_rate = 110;
+    int M_order = 4;
+    int info_seed = 12345;
+    int num_payload_hops = 10;
+    int num_frames = 200;
+
+    int expected_length = slot_frame_impl::cal_vector_len(FSY_CH_HOP, hop_rate);
+    int num_sym_head = slot_frame_impl::get_samp1hop(FSY_CH_HOP, hop_rate)[0];
+    int num_sym_pld = expected_length - num_sym_head;
+    int bytes_per_hop = num_sym_pld * 2 / 8;
+
+    // 空闲负载即无输入时的帧
+    auto idle_block = slot_frame::make(hop_rate, M_order, info_seed);
+    auto idle_head = gr::blocks::head::make(sizeof(int) * expected_length, 1);
+    auto idle_sink = gr::blocks::vector_sink_i::make(expected_length);
+    auto tb1 = gr::make_top_block("test_idle");
+    tb1->connect(idle_block, 0, idle_head, 0);
+    tb1->connect(idle_head, 0, idle_sink, 0);
+    tb1->run();
+    auto idle_frame = idle_sink->data();
+    BOOST_REQUIRE_EQUAL(idle_frame.size(), expected_length);
+
+    std::vector<uint8_t> payload(num_payload_hops * bytes_per_hop, 0x1B);
+    auto src = gr::blocks::vector_source_b::make(payload);
+    auto block = slot_frame::make(hop_rate, M_order, info_seed, true, 4);
+    auto head = gr::blocks::head::make(sizeof(int) * expected_length, num_frames);
+    auto sink = gr::blocks::vector_sink_i::make(expected_length);
+    auto tb2 = gr::make_top_block("test_payload");
+    tb2->connect(src, 0, block, 0);
+    tb2->connect(block, 0, head, 0);
+    tb2->connect(head, 0, sink, 0);
+    tb2->run();
+
+    auto data = sink->data();
+    BOOST_REQUIRE_EQUAL(data.size(), num_frames * expected_length);
+
+    // 每帧同步头相同，负载要么是输入比特，要么是空闲负载
+    int num_payload_frames = 0;
+    for (int k = 0; k < num_frames; k++) {
+        const int* frame = data.data() + k * expected_length;
+        bool is_payload = true;
+        bool is_idle = true;
+        for (int i = 0; i < expected_length; i++) {
+            if (i < num_sym_head) {
+                BOOST_REQUIRE_EQUAL(frame[i], idle_frame[i]);
+                continue;
+            }
+            is_payload &= frame[i] == (i - num_sym_head) % 4;
+            is_idle &= frame[i] == idle_frame[i];
+        }
+        BOOST_CHECK(is_payload || is_idle);
+        num_payload_frames += is_payload;
+    }
+
+    BOOST_CHECK_LE(num_payload_frames, num_payload_hops);
+    BOOST_CHECK_LE(static_cast<uint64_t>(num_payload_frames), block->payload_hops());
+    BOOST_CHECK_GE(block->payload_hops() + block->idle_hops(),
+                   static_cast<uint64_t>(num_frames));
+}
+
+BOOST_AUTO_TEST_CASE(test_slot_frame_payload_validation)
+{
+    // 负载输入要求 M_order 为 2 的幂
+    BOOST_CHECK_THROW(slot_frame::make(20, 6, 0, true), std::invalid_argument);
+    BOOST_CHECK_THROW(slot_frame::make(20, 4, 0, true, 0), std::invalid_argument);
+    BOOST_CHECK_NO_THROW(slot_frame::make(20, 6, 0, false));
+}
+
 } /* namespace freq_hopping */
 } /* namespace gr */
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <gnuradio/blocks/vector_source.h>
 #include <gnuradio/top_block.h>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <complex>
@@ -125,5 +126,231 @@ BOOST_AUTO_TEST_CASE(test_symbol_recover_multi_tag_reset)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_symbol_recover_fake_tag_and_strobe_positions)
+{
+    // 测试：输入为斜坡 0,1,2,...，输出值即为被抽样点的位置
+    int sps = 4;
+    std::vector<gr_complex> in_data(40);
+    for (size_t k = 0; k < in_data.size(); ++k) {
+        in_data[k] = gr_complex((float)k, 0.0f);
+    }
+
+    std::vector<tag_t> tags;
+    auto push = [&tags](uint64_t offset, const char* key, double value) {
+        tag_t t;
+        t.offset = offset;
+        t.key = pmt::mp(key);
+        t.value = pmt::from_double(value);
+        tags.push_back(t);
+    };
+
+    // offset 3：真标签，corr_est = 10
+    push(3, "phase_est", 0.0);
+    push(3, "corr_est", 10.0);
+    // offset 5：距离 < sps 且 corr_est 更小，是假标签，不应重置
+    push(5, "phase_est", 0.0);
+    push(5, "corr_est", 2.0);
+    // offset 20：真标签，不在原抽样网格上，重新对齐
+    push(20, "phase_est", 0.0);
+    push(20, "corr_est", 8.0);
+    // 没有 phase_est 的 corr_est 标签不影响抽样
+    push(30, "corr_est", 50.0);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto recover = symbol_recover::make(sps);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_fake_tag");
+    tb->connect(src, 0, recover, 0);
+    tb->connect(recover, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+
+    // 预期抽样位置：3, 7, 11, 15, 19（offset 20 重新对齐）20, 24, 28, 32, 36
+    std::vector<float> expected = { 3, 7, 11, 15, 19, 20, 24, 28, 32, 36 };
+    BOOST_REQUIRE_EQUAL(out_data.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        BOOST_CHECK_EQUAL(out_data[k].real(), expected[k]);
+    }
+
+    // 只有真标签被转发到输出
+    auto out_tags = sink->tags();
+    int n_phase = 0;
+    for (const auto& t : out_tags) {
+        if (pmt::symbol_to_string(t.key) == "phase_est") {
+            n_phase++;
+        }
+    }
+    BOOST_CHECK_EQUAL(n_phase, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_symbol_recover_long_strided_run)
+{
+    // 测试：标签之间的长段按步长批量抽取，跨越多次 general_work 调用
+    for (int sps : { 1, 3, 4 }) {
+        const int n = 5000;
+        std::vector<gr_complex> in_data(n);
+        for (int k = 0; k < n; ++k) {
+            in_data[k] = gr_complex((float)k, -(float)k);
+        }
+
+        std::vector<tag_t> tags;
+        for (uint64_t off : { 1u, 2001u, 3502u }) {
+            tag_t t;
+            t.offset = off;
+            t.key = pmt::mp("phase_est");
+            t.value = pmt::from_double(0.0);
+            tags.push_back(t);
+        }
+
+        auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+        auto recover = symbol_recover::make(sps);
+        auto sink = blocks::vector_sink_c::make();
+
+        auto tb = gr::make_top_block("test_strided_run");
+        tb->connect(src, 0, recover, 0);
+        tb->connect(recover, 0, sink, 0);
+        tb->run();
+
+        // 逐点参考：每个标签处重新对齐，之后每 sps 个点取一个
+        std::vector<int> expected;
+        int anchor = -1;
+        for (int k = 0; k < n; ++k) {
+            if (k == 1 || k == 2001 || k == 3502) {
+                anchor = k;
+            }
+            if (anchor >= 0 && (k - anchor) % sps == 0) {
+                expected.push_back(k);
+            }
+        }
+
+        auto out_data = sink->data();
+        BOOST_REQUIRE_EQUAL(out_data.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            BOOST_CHECK_EQUAL(out_data[k], in_data[expected[k]]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_symbol_recover_fractional_timing)
+{
+    // 测试：插值模式下在 标签位置 + time_est 处取符号
+    int sps = 2;
+    const float f = 0.01f; // 慢变复指数，插值误差很小
+    std::vector<gr_complex> in_data(400);
+    for (size_t k = 0; k < in_data.size(); ++k) {
+        in_data[k] = std::exp(gr_complex(0.0f, 2.0f * (float)M_PI * f * k));
+    }
+
+    const uint64_t tag_offset = 20;
+    const double time_est = 0.25;
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = tag_offset;
+    t.key = pmt::mp("phase_est");
+    t.value = pmt::from_double(0.0);
+    tags.push_back(t);
+    t.key = pmt::mp("time_est");
+    t.value = pmt::from_double(time_est);
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto recover = symbol_recover::make(sps, true, 0.0f); // 只对准、不跟踪
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_fractional_timing");
+    tb->connect(src, 0, recover, 0);
+    tb->connect(recover, 0, sink, 0);
+    tb->run();
+
+    auto out_data = sink->data();
+    BOOST_REQUIRE(out_data.size() > 100);
+    for (size_t k = 0; k < 100; ++k) {
+        double pos = tag_offset + time_est + (double)k * sps;
+        gr_complex expected = std::exp(gr_complex(0.0f, 2.0f * (float)M_PI * f * (float)pos));
+        BOOST_CHECK_SMALL(std::abs(out_data[k] - expected), 1e-2f);
+    }
+
+    // 标签转发到第一个符号
+    auto out_tags = sink->tags();
+    BOOST_REQUIRE_EQUAL(out_tags.size(), 1);
+    BOOST_CHECK_EQUAL(out_tags[0].offset, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_symbol_recover_gardner_tracking)
+{
+    // 测试：采样时钟比符号时钟快 1e-3，实际每符号 2.002 个样点，
+    // Gardner 环路应跟踪到该值，锁定后的符号与发送符号一致
+    const int sps = 2;
+    const double eps = 1e-3;
+    const double sps_actual = sps * (1.0 + eps);
+    const double alpha = 0.5; // 升余弦滚降，符号中心无码间干扰
+    const int nsym = 2000;
+    const int lock_in = 300;
+
+    std::vector<float> syms(nsym);
+    uint32_t lfsr = 0x1234567u;
+    for (auto& a : syms) {
+        lfsr = lfsr * 1664525u + 1013904223u;
+        a = (lfsr >> 31) ? 1.0f : -1.0f;
+    }
+
+    auto rc = [alpha](double t) {
+        double s = std::fabs(t) < 1e-9 ? 1.0 : std::sin(M_PI * t) / (M_PI * t);
+        double d = 1.0 - 4.0 * alpha * alpha * t * t;
+        double c = std::fabs(d) < 1e-9 ? M_PI / 4 : std::cos(M_PI * alpha * t) / d;
+        return s * c;
+    };
+
+    // 第 0 个符号中心在 tag_offset + time_est，第 k 个在其后 k*sps_actual 处；
+    // 输入在最后 20 个符号之前截止，保证环路一直有数据
+    const uint64_t tag_offset = 20;
+    const double time_est = 0.25;
+    const double p0 = tag_offset + time_est;
+    const int n = (int)(p0 + (nsym - 20) * sps_actual);
+    std::vector<gr_complex> in_data(n);
+    for (int k = 0; k < n; ++k) {
+        double ts = (k - p0) / sps_actual;
+        int c = (int)std::round(ts);
+        double v = 0.0;
+        for (int j = std::max(0, c - 12); j <= std::min(nsym - 1, c + 12); ++j) {
+            v += syms[j] * rc(ts - j);
+        }
+        in_data[k] = gr_complex((float)v, 0.0f);
+    }
+
+    std::vector<tag_t> tags;
+    tag_t t;
+    t.offset = tag_offset;
+    t.key = pmt::mp("phase_est");
+    t.value = pmt::from_double(0.0);
+    tags.push_back(t);
+    t.key = pmt::mp("time_est");
+    t.value = pmt::from_double(time_est);
+    tags.push_back(t);
+
+    auto src = blocks::vector_source_c::make(in_data, false, 1, tags);
+    auto recover = symbol_recover::make(sps, true, 0.05f);
+    auto sink = blocks::vector_sink_c::make();
+
+    auto tb = gr::make_top_block("test_gardner_tracking");
+    tb->connect(src, 0, recover, 0);
+    tb->connect(recover, 0, sink, 0);
+    tb->run();
+
+    // 环路收敛到实际的每符号样点数（不跟踪时停在 2.0）
+    auto impl = std::dynamic_pointer_cast<symbol_recover_impl>(recover);
+    BOOST_REQUIRE(impl);
+    BOOST_CHECK_SMALL(impl->omega() - (float)sps_actual, 5e-4f);
+
+    // 锁定后逐符号与发送符号比较；不跟踪时 500 个符号就漂移一个样点
+    auto out_data = sink->data();
+    BOOST_REQUIRE_GT(out_data.size(), (size_t)(nsym - 100));
+    for (size_t k = lock_in; k < std::min(out_data.size(), (size_t)(nsym - 20)); ++k) {
+        BOOST_CHECK_SMALL(std::abs(out_data[k] - gr_complex(syms[k], 0.0f)), 0.15f);
+    }
+}
+
 } /* namespace freq_hopping */
 } /* namespace gr */
\ No newline at end of file
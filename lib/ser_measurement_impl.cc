@@ -7,72 +7,178 @@
 
 #include "ser_measurement_impl.h"
 #include <gnuradio/io_signature.h>
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
 #include <iostream>
-#include <numeric>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace gr {
 namespace freq_hopping {
 
+// 统计 a、b 中不相等的字节数：每次比较 8 字节，异或后把每个非零字节折叠到
+// 该字节的最低位，再 popcount
+static size_t count_mismatches(const char* a, const char* b, size_t n)
+{
+    const uint64_t lsb = 0x0101010101010101ULL;
+    size_t errors = 0;
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        uint64_t wa, wb;
+        std::memcpy(&wa, a + k, 8);
+        std::memcpy(&wb, b + k, 8);
+        uint64_t x = wa ^ wb;
+        x |= x >> 4;
+        x |= x >> 2;
+        x |= x >> 1;
+        errors += __builtin_popcountll(x & lsb);
+    }
+    for (; k < n; ++k) {
+        errors += (a[k] != b[k]);
+    }
+    return errors;
+}
+
+// 每帧SER所在的直方图区间：0 单独一档，之后按 1e-4 起的十倍程划分
+static size_t ser_hist_bin(double ser, size_t nbins)
+{
+    if (ser <= 0.0) {
+        return 0;
+    }
+    double edge = 1e-4;
+    for (size_t b = 1; b + 1 < nbins; ++b) {
+        if (ser <= edge) {
+            return b;
+        }
+        edge *= 10.0;
+    }
+    return nbins - 1;
+}
+
 ser_measurement::sptr
-ser_measurement::make(const std::string& filename)
+ser_measurement::make(const std::string& filename, int frame_len, bool verbose)
 {
-    return gnuradio::make_block_sptr<ser_measurement_impl>(filename);
+    return gnuradio::make_block_sptr<ser_measurement_impl>(filename, frame_len, verbose);
 }
 
-ser_measurement_impl::ser_measurement_impl(const std::string& filename)
+ser_measurement_impl::ser_measurement_impl(const std::string& filename,
+                                           int frame_len,
+                                           bool verbose)
     : gr::block("ser_measurement",
                 gr::io_signature::make(1, 1, sizeof(char)),
                 gr::io_signature::make(0, 1, sizeof(float))),  // 修改：0个或1个输出
       d_filename(filename),
+      d_ref_data(nullptr),
+      d_ref_size(0),
+      d_ref_frames(1),
+      d_ref_frame(nullptr),
+      d_ref_frame_counter(0),
+      d_frame_num_key(pmt::mp("frame_num")),
       d_current_frame_idx(0),
       d_current_frame_errors(0),
+      d_current_frame_extra(0),
       d_frame_length(0),
-      d_total_frames(0)
+      d_ser_sum(0.0),
+      d_verbose(verbose),
+      d_stats_port(pmt::mp("stats")),
+      d_total_frames(0),
+      d_total_symbols(0),
+      d_total_errors(0),
+      d_short_frames(0),
+      d_overlong_frames(0),
+      d_average_ser(0.0)
 {
+    for (auto& bin : d_ser_hist) {
+        bin.store(0);
+    }
+
+    if (frame_len < 0) {
+        throw std::invalid_argument("ser_measurement: frame_len must be >= 0");
+    }
+
     // 加载参考文件
     if (!load_reference_file()) {
         throw std::runtime_error("Failed to load reference file: " + filename);
     }
 
-    d_frame_length = d_reference_data.size();
+    if (frame_len == 0) {
+        // 整个文件是一帧
+        d_frame_length = d_ref_size;
+    } else {
+        if (d_ref_size < (size_t)frame_len) {
+            throw std::invalid_argument("ser_measurement: reference file shorter than one frame");
+        }
+        d_frame_length = frame_len;
+        d_ref_frames = d_ref_size / d_frame_length;
+        if (d_ref_size % d_frame_length != 0) {
+            std::cerr << "Warning: reference file size " << d_ref_size
+                      << " is not a multiple of frame length " << d_frame_length
+                      << ", trailing bytes ignored" << std::endl;
+        }
+    }
+    d_ref_frame = d_ref_data;
 
     // 设置标签传播策略
     set_tag_propagation_policy(TPP_DONT);
 
+    message_port_register_out(d_stats_port);
+
     // std::cout << "SER Measurement initialized with frame length: "
     //           << d_frame_length << std::endl;
 }
 
 ser_measurement_impl::~ser_measurement_impl()
 {
+    if (d_ref_data) {
+        munmap(const_cast<char*>(d_ref_data), d_ref_size);
+    }
 }
 
 bool ser_measurement_impl::load_reference_file()
 {
-    std::ifstream file(d_filename, std::ios::binary);
-    if (!file.is_open()) {
+    int fd = open(d_filename.c_str(), O_RDONLY);
+    if (fd < 0) {
         std::cerr << "Error: Cannot open file " << d_filename << std::endl;
         return false;
     }
 
-    // 读取文件到vector
-    file.seekg(0, std::ios::end);
-    size_t file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "Error: Cannot stat file " << d_filename << std::endl;
+        close(fd);
+        return false;
+    }
+    size_t file_size = st.st_size;
 
-    d_reference_data.resize(file_size);
-    file.read(reinterpret_cast<char*>(d_reference_data.data()), file_size);
+    // 只读映射，按顺序访问；文件很大时也只有用到的页才会读入内存
+    if (file_size > 0) {
+        void* p = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "Error: Cannot mmap file " << d_filename << std::endl;
+            close(fd);
+            return false;
+        }
+        madvise(p, file_size, MADV_SEQUENTIAL);
+        d_ref_data = static_cast<const char*>(p);
+        d_ref_size = file_size;
+    }
 
-    file.close();
+    // 映射建立后即可关闭文件描述符
+    close(fd);
 
-    std::cout << "Loaded reference file: " << d_filename
-              << " (" << file_size << " bytes)" << std::endl;
+    if (d_verbose) {
+        std::cout << "Loaded reference file: " << d_filename
+                  << " (" << file_size << " bytes)" << std::endl;
+    }
 
     return true;
 }
 
-double ser_measurement_impl::handle_new_frame()
+double ser_measurement_impl::handle_new_frame(int64_t ref_frame)
 {
     double current_ser = 0.0;
 
@@ -82,34 +188,98 @@ double ser_measurement_impl::handle_new_frame()
 
         // 添加到历史记录
         d_ser_history.push_back(current_ser);
+        d_ser_sum += current_ser;
         if (d_ser_history.size() > HISTORY_SIZE) {
+            d_ser_sum -= d_ser_history.front();
             d_ser_history.pop_front();
         }
+
+        // 更新对外统计
+        d_total_symbols.fetch_add(d_current_frame_idx, std::memory_order_relaxed);
+        d_total_errors.fetch_add(d_current_frame_errors, std::memory_order_relaxed);
+        if (d_current_frame_idx < d_frame_length) {
+            d_short_frames.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (d_current_frame_extra > 0) {
+            d_overlong_frames.fetch_add(1, std::memory_order_relaxed);
+        }
+        d_ser_hist[ser_hist_bin(current_ser, SER_HIST_BINS)].fetch_add(
+            1, std::memory_order_relaxed);
+        d_average_ser.store(window_ser(), std::memory_order_relaxed);
     }
 
+    // 选择新帧的参考帧
+    uint64_t ref_idx = (ref_frame >= 0) ? (uint64_t)ref_frame : d_ref_frame_counter;
+    ref_idx %= d_ref_frames;
+    d_ref_frame = d_ref_data + ref_idx * d_frame_length;
+    d_ref_frame_counter = ref_idx + 1;
+
     // 重置当前帧统计
     d_current_frame_idx = 0;
     d_current_frame_errors = 0;
-    d_total_frames++;
-
-    // 每30帧打印一次
-    if (d_total_frames % PRINT_INTERVAL == 0) {
-        // 计算最近30帧的平均SER
-        double avg_ser = 0.0;
-        if (!d_ser_history.empty()) {
-            avg_ser = std::accumulate(d_ser_history.begin(),
-                                     d_ser_history.end(),
-                                     0.0) / d_ser_history.size();
-        }
+    d_current_frame_extra = 0;
+    uint64_t total = d_total_frames.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // 每 PRINT_INTERVAL 帧发布一次统计
+    if (total % PRINT_INTERVAL == 0) {
+        publish_stats();
+    }
 
+    return current_ser;
+}
+
+void ser_measurement_impl::publish_stats()
+{
+    std::vector<uint64_t> bins = ser_histogram();
+    pmt::pmt_t hist = pmt::init_u64vector(bins.size(), bins.data());
+
+    pmt::pmt_t stats = pmt::make_dict();
+    stats = pmt::dict_add(stats, pmt::mp("total_frames"), pmt::from_uint64(total_frames()));
+    stats = pmt::dict_add(stats, pmt::mp("total_symbols"), pmt::from_uint64(total_symbols()));
+    stats = pmt::dict_add(stats, pmt::mp("total_errors"), pmt::from_uint64(total_errors()));
+    stats = pmt::dict_add(stats, pmt::mp("average_ser"), pmt::from_double(average_ser()));
+    stats = pmt::dict_add(stats, pmt::mp("short_frames"), pmt::from_uint64(short_frames()));
+    stats = pmt::dict_add(
+        stats, pmt::mp("overlong_frames"), pmt::from_uint64(overlong_frames()));
+    stats = pmt::dict_add(stats, pmt::mp("ser_histogram"), hist);
+    message_port_pub(d_stats_port, stats);
+
+    if (d_verbose) {
         std::cout << "========================================" << std::endl;
-        std::cout << "Total Frames Received: " << d_total_frames << std::endl;
+        std::cout << "Total Frames Received: " << total_frames() << std::endl;
         std::cout << "Average SER (last " << d_ser_history.size()
-                  << " frames): " << avg_ser << std::endl;
-        // std::cout << "Current Frame SER: " << current_ser << std::endl;
+                  << " frames): " << average_ser() << std::endl;
     }
+}
 
-    return current_ser;
+std::vector<uint64_t> ser_measurement_impl::ser_histogram() const
+{
+    std::vector<uint64_t> bins(SER_HIST_BINS);
+    for (size_t b = 0; b < SER_HIST_BINS; ++b) {
+        bins[b] = d_ser_hist[b].load(std::memory_order_relaxed);
+    }
+    return bins;
+}
+
+double ser_measurement_impl::window_ser() const
+{
+    if (d_ser_history.empty()) {
+        return 0.0;
+    }
+    return d_ser_sum / d_ser_history.size();
+}
+
+void ser_measurement_impl::compare_segment(const char* in, size_t n)
+{
+    // 超出帧长度的部分可能是同步问题，继续处理但不计入统计
+    size_t ncmp = std::min(n, d_frame_length - std::min(d_current_frame_idx, d_frame_length));
+    d_current_frame_extra += n - ncmp;
+    if (ncmp == 0) {
+        return;
+    }
+    d_current_frame_errors +=
+        count_mismatches(in, d_ref_frame + d_current_frame_idx, ncmp);
+    d_current_frame_idx += ncmp;
 }
 
 void ser_measurement_impl::forecast(int noutput_items,
@@ -137,58 +307,79 @@ int ser_measurement_impl::general_work(int noutput_items,
     // 获取所有phase_est标签
     std::vector<tag_t> tags;
     get_tags_in_window(tags, 0, 0, nin, pmt::string_to_symbol("phase_est"));
+    std::vector<tag_t> tags_frame_num;
+    get_tags_in_window(tags_frame_num, 0, 0, nin, d_frame_num_key);
+    auto by_offset = [](const tag_t& a, const tag_t& b) { return a.offset < b.offset; };
+    std::sort(tags.begin(), tags.end(), by_offset);
+    std::sort(tags_frame_num.begin(), tags_frame_num.end(), by_offset);
+    size_t frame_num_idx = 0;
 
+    const uint64_t n0 = nitems_read(0);
     int consumed = 0;
     size_t tag_idx = 0;
 
-    for (int i = 0; i < nin && (!has_output || nout < noutput_items); i++) {
+    // 按标签把输入分成若干段，每段整体与参考帧比较
+    int i = 0;
+    while (i < nin) {
+        if (has_output && nout >= noutput_items) {
+            break;
+        }
+
         // 检查是否有phase_est标签
-        if (tag_idx < tags.size() &&
-            (tags[tag_idx].offset - nitems_read(0)) == static_cast<uint64_t>(i)) {
+        if (tag_idx < tags.size() && (tags[tag_idx].offset - n0) == static_cast<uint64_t>(i)) {
 
             // 新帧开始，输出上一帧的SER（如果有输出连接）
-            if (has_output && (d_total_frames > 0 || d_current_frame_idx > 0)) {
+            if (has_output && (d_total_frames.load(std::memory_order_relaxed) > 0 ||
+                               d_current_frame_idx > 0)) {
                 // 计算并输出平均SER
                 double avg_ser = 0.0;
                 if (!d_ser_history.empty()) {
-                    avg_ser = std::accumulate(d_ser_history.begin(), 
-                                            d_ser_history.end(), 
-                                            0.0) / d_ser_history.size();
+                    avg_ser = window_ser();
                 } else if (d_current_frame_idx > 0) {
                     // 第一帧，使用当前帧的SER
                     avg_ser = static_cast<double>(d_current_frame_errors) / d_current_frame_idx;
                 }
-                
+
                 out[nout] = static_cast<float>(avg_ser);
-                
-                // // 添加标签到输出
-                // add_item_tag(0, nitems_written(0) + nout,
-                //            pmt::string_to_symbol("phase_est"),
-                //            pmt::from_long(d_total_frames),
-                //            pmt::string_to_symbol(name()));
-                
                 nout++;
             }
-            
-            // 处理新帧
-            handle_new_frame();
-            tag_idx++;
-        }
-        
-        // 比较数据
-        if (d_current_frame_idx < d_frame_length) {
-            if (in[i] != d_reference_data[d_current_frame_idx]) {
-                d_current_frame_errors++;
+
+            // 同一位置的 frame_num 标签指定参考帧
+            int64_t ref_frame = -1;
+            while (frame_num_idx < tags_frame_num.size() &&
+                   tags_frame_num[frame_num_idx].offset < tags[tag_idx].offset) {
+                frame_num_idx++;
+            }
+            if (frame_num_idx < tags_frame_num.size() &&
+                tags_frame_num[frame_num_idx].offset == tags[tag_idx].offset) {
+                ref_frame = (int64_t)pmt::to_uint64(tags_frame_num[frame_num_idx].value);
+            }
+
+            // 处理新帧；同一位置的多个标签只算一帧
+            handle_new_frame(ref_frame);
+            while (tag_idx < tags.size() &&
+                   (tags[tag_idx].offset - n0) == static_cast<uint64_t>(i)) {
+                tag_idx++;
+            }
+
+            if (has_output && nout >= noutput_items) {
+                // 输出已满：只处理标签所在的这个样点
+                compare_segment(in + i, 1);
+                consumed = i + 1;
+                break;
             }
-            d_current_frame_idx++;
-        } else {
-            // 超出帧长度，可能是同步问题
-            // 继续处理但不计入统计
         }
-        
-        consumed = i + 1;
+
+        // 比较数据：一直到下一个标签
+        int seg_end = nin;
+        if (tag_idx < tags.size()) {
+            seg_end = static_cast<int>(tags[tag_idx].offset - n0);
+        }
+        compare_segment(in + i, seg_end - i);
+        i = seg_end;
+        consumed = i;
     }
-    
+
     // 消费所有处理过的输入
     consume_each(consumed);
     
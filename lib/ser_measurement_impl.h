@@ -9,6 +9,9 @@
 #define INCLUDED_FREQ_HOPPING_SER_MEASUREMENT_IMPL_H
 
 #include <gnuradio/freq_hopping/ser_measurement.h>
+#include <array>
+#include <atomic>
+#include <deque>
 
 namespace gr {
 namespace freq_hopping {
@@ -17,33 +20,62 @@ class ser_measurement_impl : public ser_measurement
 {
 private:
     static constexpr size_t HISTORY_SIZE = 100;      // 保存最近N帧
-    static constexpr size_t PRINT_INTERVAL = 100;    // 每N帧打印一次统计
+    static constexpr size_t PRINT_INTERVAL = 100;    // 每N帧发布（打印）一次统计
+    static constexpr size_t SER_HIST_BINS = 6;       // 每帧SER直方图的区间数
 
-    std::vector<char> d_reference_data;  // 参考数据（一帧）
     std::string d_filename;
 
+    // 参考数据（内存映射，可包含多帧）
+    const char* d_ref_data;              // 映射起始地址
+    size_t d_ref_size;                   // 映射字节数
+    size_t d_ref_frames;                 // 参考帧数
+    const char* d_ref_frame;             // 当前帧对应的参考帧
+    uint64_t d_ref_frame_counter;        // 没有 frame_num 标签时按顺序选择参考帧
+    pmt::pmt_t d_frame_num_key;          // "frame_num"
+
     // 当前帧统计
     size_t d_current_frame_idx;          // 当前帧内的索引位置
     size_t d_current_frame_errors;       // 当前帧的错误数
+    size_t d_current_frame_extra;        // 当前帧超出帧长的符号数
     size_t d_frame_length;               // 帧长度
 
     // 历史统计
     std::deque<double> d_ser_history;    // 最近30帧的SER
-    size_t d_total_frames;               // 总帧数
+    double d_ser_sum;                    // d_ser_history 的滑动和
+    bool d_verbose;
+    pmt::pmt_t d_stats_port;             // "stats"
+
+    // 对外的统计快照：只在帧结束时由工作线程更新，可随时从其他线程读取
+    std::atomic<uint64_t> d_total_frames;    // 总帧数
+    std::atomic<uint64_t> d_total_symbols;
+    std::atomic<uint64_t> d_total_errors;
+    std::atomic<uint64_t> d_short_frames;
+    std::atomic<uint64_t> d_overlong_frames;
+    std::atomic<double> d_average_ser;
+    std::array<std::atomic<uint64_t>, SER_HIST_BINS> d_ser_hist;
 
+    // 发布统计消息，verbose 时同时打印
+    void publish_stats();
 
 
-    // 读取参考文件
+    // 映射参考文件
     bool load_reference_file();
 
-    // 处理新帧开始，返回当前帧的SER
-    double handle_new_frame();
+    // 处理新帧开始，返回当前帧的SER。ref_frame 为新帧使用的参考帧序号，
+    // 小于 0 时按顺序取下一帧
+    double handle_new_frame(int64_t ref_frame = -1);
 
     // 计算并更新SER
     void update_ser();
 
+    // 最近 HISTORY_SIZE 帧的平均SER（滑动和，O(1)）
+    double window_ser() const;
+
+    // 把 n 个输入符号与参考帧当前位置比较，累加错误数
+    void compare_segment(const char* in, size_t n);
+
 public:
-    ser_measurement_impl(const std::string& filename);
+    ser_measurement_impl(const std::string& filename, int frame_len, bool verbose);
     ~ser_measurement_impl();
 
     // Where all the action really happens
@@ -53,6 +85,14 @@ public:
                      gr_vector_int& ninput_items,
                      gr_vector_const_void_star& input_items,
                      gr_vector_void_star& output_items);
+
+    uint64_t total_frames() const override { return d_total_frames.load(); }
+    uint64_t total_symbols() const override { return d_total_symbols.load(); }
+    uint64_t total_errors() const override { return d_total_errors.load(); }
+    double average_ser() const override { return d_average_ser.load(); }
+    uint64_t short_frames() const override { return d_short_frames.load(); }
+    uint64_t overlong_frames() const override { return d_overlong_frames.load(); }
+    std::vector<uint64_t> ser_histogram() const override;
 };
 
 } // namespace freq_hopping
@@ -13,23 +13,37 @@ namespace freq_hopping {
 
 #pragma message("set the following appropriately and remove this warning")
 using output_type = int;
-slot_frame::sptr slot_frame::make(int hop_rate, int M_order, int info_seed)
+slot_frame::sptr slot_frame::make(
+    int hop_rate, int M_order, int info_seed, bool payload_input, int max_buffered_hops)
 {
-    return gnuradio::make_block_sptr<slot_frame_impl>(hop_rate, M_order, info_seed);
+    return gnuradio::make_block_sptr<slot_frame_impl>(
+        hop_rate, M_order, info_seed, payload_input, max_buffered_hops);
 }
 
 
 /*
  * The private constructor
  */
-slot_frame_impl::slot_frame_impl(int hop_rate, int M_order, int info_seed)
-    : gr::sync_block("slot_frame",
-                     gr::io_signature::make(0, 0, 0),
-                     gr::io_signature::make(1 , 1 , sizeof(output_type) * cal_vector_len(FSY_CH_HOP,hop_rate))),
+slot_frame_impl::slot_frame_impl(int hop_rate,
+                                 int M_order,
+                                 int info_seed,
+                                 bool payload_input,
+                                 int max_buffered_hops)
+    : gr::block("slot_frame",
+                payload_input ? gr::io_signature::make(1, 1, sizeof(uint8_t))
+                              : gr::io_signature::make(0, 0, 0),
+                gr::io_signature::make(1 , 1 , sizeof(output_type) * cal_vector_len(FSY_CH_HOP,hop_rate))),
     d_hop_rate(hop_rate),
     d_M_order(M_order),
     d_info_seed(info_seed),
-    d_hops_count(0)
+    d_hops_count(0),
+    d_payload_input(payload_input),
+    d_bits_per_sym(0),
+    d_bits_per_hop(0),
+    d_max_bits(0),
+    d_read_bit(0),
+    d_payload_hops(0),
+    d_idle_hops(0)
 {
     // 使用静态函数获取参数
     try {
@@ -42,6 +56,25 @@ slot_frame_impl::slot_frame_impl(int hop_rate, int M_order, int info_seed)
         num_sym_head = 108;
         num_sym_pld = 324;
     }
+
+    // 每帧内容相同，只生成一次帧模板
+    generate_frame();
+
+    // 负载输入：每个符号 log2(M) 比特
+    if (d_payload_input) {
+        if (d_M_order < 2 || (d_M_order & (d_M_order - 1)) != 0) {
+            throw std::invalid_argument("M_order must be a power of 2 for payload input");
+        }
+        if (max_buffered_hops < 1) {
+            throw std::invalid_argument("max_buffered_hops must be positive");
+        }
+        while ((1 << d_bits_per_sym) < d_M_order) {
+            d_bits_per_sym++;
+        }
+        d_bits_per_hop = num_sym_pld * d_bits_per_sym;
+        d_max_bits = static_cast<size_t>(max_buffered_hops) * d_bits_per_hop;
+        d_bytes.reserve(d_max_bits / 8 + 1);
+    }
 }
 
 /*
@@ -49,25 +82,91 @@ slot_frame_impl::slot_frame_impl(int hop_rate, int M_order, int info_seed)
  */
 slot_frame_impl::~slot_frame_impl() {}
 
-int slot_frame_impl::work(int noutput_items,
-                          gr_vector_const_void_star& input_items,
-                          gr_vector_void_star& output_items)
+void slot_frame_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required)
+{
+    // 输入不足时发送空闲负载，不等待输入
+    for (auto& n : ninput_items_required) {
+        n = 0;
+    }
+}
+
+int slot_frame_impl::buffer_input(const uint8_t* in, int ninput)
+{
+    // 只读取缓冲放得下的整字节，缓冲满时上游被背压
+    int nbytes = std::min<int>(ninput, (d_max_bits - buffered_bits()) / 8);
+    d_bytes.insert(d_bytes.end(), in, in + nbytes);
+    return nbytes;
+}
+
+int slot_frame_impl::read_bits(int n)
+{
+    // 每次从当前字节取尽可能多的比特
+    int value = 0;
+    while (n > 0) {
+        int avail = 8 - static_cast<int>(d_read_bit % 8);
+        int k = std::min(n, avail);
+        int bits = (d_bytes[d_read_bit / 8] >> (avail - k)) & ((1 << k) - 1);
+        value = (value << k) | bits;
+        d_read_bit += k;
+        n -= k;
+    }
+    return value;
+}
+
+void slot_frame_impl::pack_payload(int* pld)
+{
+    // 高位在前，每 log2(M) 比特组成一个符号
+    for (int i = 0; i < num_sym_pld; i++) {
+        pld[i] = read_bits(d_bits_per_sym);
+    }
+}
+
+int slot_frame_impl::general_work(int noutput_items,
+                                  gr_vector_int& ninput_items,
+                                  gr_vector_const_void_star& input_items,
+                                  gr_vector_void_star& output_items)
 {
     auto out = static_cast<output_type*>(output_items[0]);
-    int vec_len = num_sym_head + num_sym_pld;
-
-    int vectors_produced = 0;
-    for (int i = 0; i < noutput_items; i++) {
-        // 生成下一帧数据
-        generate_frame();
-        // 复制当前帧数据到输出缓冲区
-        std::copy(d_cnt_frame.begin(), d_cnt_frame.end(), out+(i * vec_len));
-        vectors_produced++;
-        d_hops_count++;
+    const size_t vec_len = d_cnt_frame.size();
+    const size_t total_len = noutput_items * vec_len;
+
+    // 先复制一帧模板，再把已写好的帧成倍复制，log2(noutput_items) 次 memcpy 填满输出
+    memcpy(out, d_cnt_frame.data(), vec_len * sizeof(output_type));
+    size_t filled = vec_len;
+    while (filled < total_len) {
+        size_t n = std::min(filled, total_len - filled);
+        memcpy(out + filled, out, n * sizeof(output_type));
+        filled += n;
     }
 
+    // 有负载输入时，用缓冲中的比特替换模板中的空闲负载
+    if (d_payload_input) {
+        auto in = static_cast<const uint8_t*>(input_items[0]);
+        int nconsumed = buffer_input(in, ninput_items[0]);
+
+        for (int i = 0; i < noutput_items; i++) {
+            if (buffered_bits() >= static_cast<size_t>(d_bits_per_hop)) {
+                pack_payload(out + i * vec_len + num_sym_head);
+                d_payload_hops++;
+            } else {
+                d_idle_hops++;
+            }
+
+            // 每发出一跳，缓冲腾出空间后继续读取输入
+            nconsumed += buffer_input(in + nconsumed, ninput_items[0] - nconsumed);
+        }
+        consume(0, nconsumed);
+
+        // 丢掉已发送完的整字节
+        size_t done = d_read_bit / 8;
+        d_bytes.erase(d_bytes.begin(), d_bytes.begin() + done);
+        d_read_bit -= done * 8;
+    }
+
+    d_hops_count += noutput_items;
+
     // 返回产生的向量数量
-    return vectors_produced;
+    return noutput_items;
 }
 
 // 生成帧数据的辅助函数
@@ -9,6 +9,7 @@
 #define INCLUDED_FREQ_HOPPING_SLOT_FRAME_IMPL_H
 
 #include <gnuradio/freq_hopping/slot_frame.h>
+#include <atomic>
 #include <vector>
 #include <random>
 
@@ -27,20 +28,48 @@ private:
     int num_sym_head;
     int num_sym_pld;
 
-    std::vector<int> d_cnt_frame;
+    std::vector<int> d_cnt_frame; // 帧模板：同步头和信息序列每帧相同，构造时生成一次
     int d_hops_count;
 
-    // 生成帧数据的辅助函数
+    // 负载输入（payload_input 时有效）
+    bool d_payload_input;
+    int d_bits_per_sym;
+    int d_bits_per_hop;
+    size_t d_max_bits;
+    std::vector<uint8_t> d_bytes; // 待发送的字节（按字节打包）
+    size_t d_read_bit;            // d_bytes 中下一个待发送比特的位置
+    std::atomic<uint64_t> d_payload_hops;
+    std::atomic<uint64_t> d_idle_hops;
+
+    // 生成帧模板的辅助函数
     void generate_frame();
+    // 从输入读取字节到比特缓冲，返回读取的字节数
+    int buffer_input(const uint8_t* in, int ninput);
+    // 缓冲中还未发送的比特数
+    size_t buffered_bits() const { return d_bytes.size() * 8 - d_read_bit; }
+    // 从缓冲读取 n 比特（高位在前）
+    int read_bits(int n);
+    // 从比特缓冲取一跳负载，按 M 进制符号写入 pld
+    void pack_payload(int* pld);
 
 public:
-    slot_frame_impl(int hop_rate, int M_order, int info_seed);
+    slot_frame_impl(int hop_rate,
+                    int M_order,
+                    int info_seed,
+                    bool payload_input,
+                    int max_buffered_hops);
     ~slot_frame_impl();
 
+    uint64_t payload_hops() const override { return d_payload_hops.load(); }
+    uint64_t idle_hops() const override { return d_idle_hops.load(); }
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+
     // Where all the action really happens
-    int work(int noutput_items,
-             gr_vector_const_void_star& input_items,
-             gr_vector_void_star& output_items);
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items) override;
 
     // 输出向量的长度， in sym
     static int cal_vector_len(int samp_rate, int hop_rate)
@@ -1,15 +1,20 @@
 #include "symbol_recover_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 
 namespace gr {
 namespace freq_hopping {
-symbol_recover::sptr symbol_recover::make(int sps)
+symbol_recover::sptr symbol_recover::make(int sps, bool interpolate, float ted_gain)
 {
-    return gnuradio::make_block_sptr<symbol_recover_impl>(sps);
+    return gnuradio::make_block_sptr<symbol_recover_impl>(sps, interpolate, ted_gain);
 }
 
-symbol_recover_impl::symbol_recover_impl(int sps)
+symbol_recover_impl::symbol_recover_impl(int sps, bool interpolate, float ted_gain)
     : block("symbol_recover",
             io_signature::make(1, 1, sizeof(gr_complex)), // 输入: 带有tag的complex
             io_signature::make(1, 1, sizeof(gr_complex))), // 输出: 抽样后的complex
@@ -18,18 +23,75 @@ symbol_recover_impl::symbol_recover_impl(int sps)
       d_phase_corr(0.0),
       d_is_synced(false),
       d_tag_key(pmt::mp("phase_est")),
+      d_corr_key(pmt::mp("corr_est")),
       last_tag_offset(0),  // 修正拼写
-      last_tag_value(0.0f)
+      last_tag_value(0.0f),
+      d_interpolate(interpolate),
+      d_time_key(pmt::mp("time_est")),
+      d_gain_mu(ted_gain),
+      d_gain_omega(0.25f * ted_gain * ted_gain),
+      d_omega((float)sps),
+      d_omega_lim(0.005f * sps),
+      d_mu(0.0f),
+      d_next_sym(0),
+      d_tag_floor(0),
+      d_last_sym(0.0f, 0.0f),
+      d_have_last(false),
+      d_pending_tag(false),
+      d_pending_val(pmt::get_PMT_NIL()),
+      d_pending_corr(false),
+      d_pending_corr_val(pmt::get_PMT_NIL())
 {
+    if (sps < 1) {
+        throw std::invalid_argument("symbol_recover: sps must be >= 1");
+    }
+    if (interpolate && ted_gain < 0.0f) {
+        throw std::invalid_argument("symbol_recover: ted_gain must be >= 0");
+    }
     set_tag_propagation_policy(TPP_DONT);
 }
 
 symbol_recover_impl::~symbol_recover_impl() {}
 
+void symbol_recover_impl::copy_strided(gr_complex* out,
+                                       const gr_complex* in,
+                                       int sps,
+                                       int n)
+{
+    if (sps == 1) {
+        std::memcpy(out, in, n * sizeof(gr_complex));
+        return;
+    }
+
+    // 4 路展开，减少循环开销，让编译器可以把 load/store 排在一起
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        out[k] = in[0];
+        out[k + 1] = in[sps];
+        out[k + 2] = in[2 * sps];
+        out[k + 3] = in[3 * sps];
+        in += 4 * sps;
+    }
+    for (; k < n; ++k) {
+        out[k] = *in;
+        in += sps;
+    }
+}
+
 void symbol_recover_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
 {
     // 粗略估计：输出 1 个点约需要 sps 个输入点
     ninput_items_required[0] = noutput_items * d_sps;
+    if (d_interpolate) {
+        // 插值器窗口和 Gardner 半符号点需要前后多留一些样点
+        ninput_items_required[0] += d_interp.ntaps() + lookback();
+    }
+}
+
+int symbol_recover_impl::lookback() const
+{
+    // 符号中心之前需要保留的样点：半个符号（Gardner 中点）+ 插值器左半窗口
+    return (int)std::ceil(0.5f * (d_sps + d_omega_lim)) + (int)d_interp.ntaps();
 }
 
 int symbol_recover_impl::general_work(int noutput_items,
@@ -37,6 +99,10 @@ int symbol_recover_impl::general_work(int noutput_items,
                                       gr_vector_const_void_star &input_items,
                                       gr_vector_void_star &output_items)
 {
+    if (d_interpolate) {
+        return general_work_interp(noutput_items, ninput_items, input_items, output_items);
+    }
+
     const gr_complex *in = (const gr_complex *)input_items[0];
     gr_complex *out = (gr_complex *)output_items[0];
 
@@ -46,7 +112,7 @@ int symbol_recover_impl::general_work(int noutput_items,
     // 获取当前 buffer 范围内的所有标签
     std::vector<tag_t> tags, tags_corr;
     get_tags_in_range(tags, 0, nitems_read(0), nitems_read(0) + ninput, d_tag_key);
-    get_tags_in_range(tags_corr, 0, nitems_read(0), nitems_read(0) + ninput, pmt::mp("corr_est"));
+    get_tags_in_range(tags_corr, 0, nitems_read(0), nitems_read(0) + ninput, d_corr_key);
 
     // 为了方便处理，将标签按偏移量排序（通常已排序）
     std::sort(tags.begin(), tags.end(), [](const tag_t &a, const tag_t &b) {
@@ -56,62 +122,106 @@ int symbol_recover_impl::general_work(int noutput_items,
         return a.offset < b.offset;
     });
 
+    // 两个游标分别走 phase_est 和 corr_est 标签，样点循环只在标签和抽样点之间跳转
+    const uint64_t n0 = nitems_read(0);
     auto tag_it = tags.begin();
+    auto corr_it = tags_corr.begin();
 
-    for (int i = 0; i < ninput; ++i) {
-        uint64_t abs_offset = nitems_read(0) + i;
-        bool has_tag = false;
+    int i = 0;
+    while (i < ninput) {
+        // 下一个 phase_est 标签的位置（相对本次输入）
+        int next_tag = (tag_it != tags.end()) ? static_cast<int>(tag_it->offset - n0) : ninput;
 
-        // 检查当前点是否有 phase_est 标签
-        pmt::pmt_t pmt_val = pmt::get_PMT_NIL();
-        if (tag_it != tags.end() && tag_it->offset == abs_offset) {
-            // 提取相位值
-            d_phase_corr = (float)pmt::to_double(tag_it->value);
-            pmt_val = tag_it->value;
-
-            // 查找同一位置的 corr_est 标签
-            float d_corr_est = 0.0f;
-            bool found_corr = false;
-            for (const auto& corr_tag : tags_corr) {
-                if (corr_tag.offset == abs_offset) {
-                    d_corr_est = (float)pmt::to_double(corr_tag.value);
-                    found_corr = true;
-                    break;
+        // 已同步时，把下一个标签之前的所有 sps 整数倍抽样点一次性按步长复制
+        if (d_is_synced) {
+            int next_strobe = i + (d_sps - d_counter);
+            if (next_strobe < next_tag) {
+                int nstrobes = (next_tag - 1 - next_strobe) / d_sps + 1;
+                int nroom = noutput_items - nproduced;
+                int ncopy = std::min(nstrobes, nroom);
+
+                copy_strided(out + nproduced, in + next_strobe, d_sps, ncopy);
+                nproduced += ncopy;
+
+                if (ncopy < nstrobes) {
+                    // 如果输出缓存满了，停在下一个未输出的抽样点
+                    d_counter = d_sps;
+                    consume_each(next_strobe + ncopy * d_sps);
+                    return nproduced;
                 }
+
+                // 从最后一个抽样点开始重新计数
+                int last_strobe = next_strobe + (ncopy - 1) * d_sps;
+                d_counter = 1;
+                i = last_strobe + 1;
+                continue;
             }
+        }
 
-            // 判断是否为假标签
-            bool is_fake_tag = false;
-            if (last_tag_offset != 0 && found_corr) {
-                uint64_t distance = abs_offset - last_tag_offset;
-                if (distance < (uint64_t)d_sps && d_corr_est < last_tag_value) {
-                    // 说明这个phase_est标签是假的，是由于corr_est切断了信号而产生的
-                    is_fake_tag = true;
-                }
+        // 下一个标签之前没有抽样点，直接跳到标签处
+        if (next_tag >= ninput) {
+            if (d_is_synced) {
+                d_counter += ninput - i;
             }
+            i = ninput;
+            break;
+        }
+        if (d_is_synced) {
+            d_counter += next_tag - i;
+        }
+        i = next_tag;
 
-            if (!is_fake_tag) {
-                // 触发同步：重置计数器
-                d_counter = 0;
-                d_is_synced = true;
-                has_tag = true;
+        uint64_t abs_offset = n0 + i;
+        bool has_tag = false;
 
-                // 更新last_tag信息
-                last_tag_offset = abs_offset;
-                if (found_corr) {
-                    last_tag_value = d_corr_est;
-                }
+        // 提取相位值
+        d_phase_corr = (float)pmt::to_double(tag_it->value);
+        pmt::pmt_t pmt_val = tag_it->value;
+
+        // 查找同一位置的 corr_est 标签（corr_est 游标只前进不回退）
+        while (corr_it != tags_corr.end() && corr_it->offset < abs_offset) {
+            ++corr_it;
+        }
+        float d_corr_est = 0.0f;
+        bool found_corr = false;
+        pmt::pmt_t corr_val = pmt::get_PMT_NIL();
+        if (corr_it != tags_corr.end() && corr_it->offset == abs_offset) {
+            d_corr_est = (float)pmt::to_double(corr_it->value);
+            found_corr = true;
+            corr_val = corr_it->value;
+        }
+
+        // 判断是否为假标签
+        bool is_fake_tag = false;
+        if (last_tag_offset != 0 && found_corr) {
+            uint64_t distance = abs_offset - last_tag_offset;
+            if (distance < (uint64_t)d_sps && d_corr_est < last_tag_value) {
+                // 说明这个phase_est标签是假的，是由于corr_est切断了信号而产生的
+                is_fake_tag = true;
+            }
+        }
+
+        if (!is_fake_tag) {
+            // 触发同步：重置计数器
+            d_counter = 0;
+            d_is_synced = true;
+            has_tag = true;
+
+            // 更新last_tag信息
+            last_tag_offset = abs_offset;
+            if (found_corr) {
+                last_tag_value = d_corr_est;
             }
+        }
 
-            tag_it++;
+        // 同一位置的多个 phase_est 标签只处理第一个
+        while (tag_it != tags.end() && tag_it->offset == abs_offset) {
+            ++tag_it;
         }
 
         // 逻辑判断：如果是标签所在点，或者是同步后的 sps 整数倍点
         if (d_is_synced && (has_tag || d_counter == d_sps)) {
             if (nproduced < noutput_items) {
-                // 执行相位纠正：out = in * exp(-j * phase)
-                // gr_complex rot = std::exp(gr_complex(0.0, -d_phase_corr));
-                // out[nproduced] = in[i] * rot;
                 out[nproduced] = in[i]; // 在symbol中不纠相偏，放到costas环中进行
 
                 // --- 手动转发标签 ---
@@ -122,6 +232,10 @@ int symbol_recover_impl::general_work(int noutput_items,
                                  d_tag_key,                      // 标签 Key
                                  pmt_val                         // 标签 Value
                     );
+                    // 相关幅度一并转发，供 frame_recover 写入 PDU 元数据
+                    if (found_corr) {
+                        add_item_tag(0, nitems_written(0) + nproduced, d_corr_key, corr_val);
+                    }
                 }
                 // ------------------
                 nproduced++;
@@ -135,11 +249,176 @@ int symbol_recover_impl::general_work(int noutput_items,
         }
 
         d_counter++;
+        i++;
     }
 
     consume_each(ninput);
     return nproduced;
 }
 
+int symbol_recover_impl::general_work_interp(int noutput_items,
+                                             gr_vector_int& ninput_items,
+                                             gr_vector_const_void_star& input_items,
+                                             gr_vector_void_star& output_items)
+{
+    const gr_complex* in = (const gr_complex*)input_items[0];
+    gr_complex* out = (gr_complex*)output_items[0];
+
+    const int ninput = ninput_items[0];
+    const uint64_t n0 = nitems_read(0);
+    const uint64_t n_end = n0 + ninput;
+    // mmse 插值器输出 in[half + mu]，窗口为 in[0] ~ in[ntaps-1]
+    const int ntaps = (int)d_interp.ntaps();
+    const int half = ntaps / 2 - 1;
+    int nproduced = 0;
+
+    std::vector<tag_t> tags, tags_corr, tags_time;
+    get_tags_in_range(tags, 0, n0, n_end, d_tag_key);
+    get_tags_in_range(tags_corr, 0, n0, n_end, d_corr_key);
+    get_tags_in_range(tags_time, 0, n0, n_end, d_time_key);
+    auto by_offset = [](const tag_t& a, const tag_t& b) { return a.offset < b.offset; };
+    std::sort(tags.begin(), tags.end(), by_offset);
+    std::sort(tags_corr.begin(), tags_corr.end(), by_offset);
+    std::sort(tags_time.begin(), tags_time.end(), by_offset);
+
+    auto tag_it = tags.begin();
+    auto corr_it = tags_corr.begin();
+    auto time_it = tags_time.begin();
+
+    // 为插值保留的回看样点已经处理过，其中的标签跳过
+    while (tag_it != tags.end() && tag_it->offset < d_tag_floor) {
+        ++tag_it;
+    }
+
+    while (true) {
+        uint64_t next_tag =
+            (tag_it != tags.end()) ? tag_it->offset : std::numeric_limits<uint64_t>::max();
+
+        if (d_is_synced && d_next_sym < next_tag) {
+            // 下一个事件是符号中心：需要完整的插值窗口
+            int64_t rel = (int64_t)(d_next_sym - n0);
+            if (rel + ntaps - half > ninput || nproduced >= noutput_items) {
+                break;
+            }
+            if (rel < half) {
+                // 标签落在流的最开始，左侧窗口不够，跳过这个符号
+                d_next_sym += (uint64_t)std::max(1.0f, std::floor(d_mu + d_omega));
+                continue;
+            }
+
+            gr_complex y = d_interp.interpolate(in + rel - half, d_mu);
+
+            // Gardner 定时误差：e = Re{(y[n-1] - y[n]) * conj(y[n-1/2])}
+            float err = 0.0f;
+            if (d_have_last && d_gain_mu > 0.0f) {
+                float mid = (float)rel + d_mu - 0.5f * d_omega;
+                float mid_int = std::floor(mid);
+                int64_t mi = (int64_t)mid_int;
+                if (mi >= half) {
+                    gr_complex y_mid = d_interp.interpolate(in + mi - half, mid - mid_int);
+                    err = std::real((d_last_sym - y) * std::conj(y_mid));
+                    err = std::max(-1.0f, std::min(1.0f, err));
+                }
+            }
+
+            out[nproduced] = y;
+            if (d_pending_tag) {
+                add_item_tag(0, nitems_written(0) + nproduced, d_tag_key, d_pending_val);
+                if (d_pending_corr) {
+                    add_item_tag(0, nitems_written(0) + nproduced, d_corr_key, d_pending_corr_val);
+                }
+                d_pending_tag = false;
+            }
+            nproduced++;
+            d_last_sym = y;
+            d_have_last = true;
+
+            // 二阶环路：先调整每符号采样点数，再推进到下一个符号中心
+            d_omega += d_gain_omega * err;
+            d_omega = std::max((float)d_sps - d_omega_lim,
+                               std::min((float)d_sps + d_omega_lim, d_omega));
+            float adv = d_mu + d_omega + d_gain_mu * err;
+            float step = std::floor(adv);
+            d_mu = adv - step;
+            d_next_sym += (uint64_t)step;
+            continue;
+        }
+
+        if (next_tag >= n_end) {
+            break;
+        }
+
+        // 下一个事件是 phase_est 标签
+        d_phase_corr = (float)pmt::to_double(tag_it->value);
+        pmt::pmt_t pmt_val = tag_it->value;
+
+        while (corr_it != tags_corr.end() && corr_it->offset < next_tag) {
+            ++corr_it;
+        }
+        float d_corr_est = 0.0f;
+        bool found_corr = false;
+        pmt::pmt_t corr_val = pmt::get_PMT_NIL();
+        if (corr_it != tags_corr.end() && corr_it->offset == next_tag) {
+            d_corr_est = (float)pmt::to_double(corr_it->value);
+            found_corr = true;
+            corr_val = corr_it->value;
+        }
+
+        while (time_it != tags_time.end() && time_it->offset < next_tag) {
+            ++time_it;
+        }
+        double time_est = 0.0;
+        if (time_it != tags_time.end() && time_it->offset == next_tag) {
+            time_est = pmt::to_double(time_it->value);
+        }
+
+        // 与整数模式相同的假标签判断
+        bool is_fake_tag = false;
+        if (last_tag_offset != 0 && found_corr) {
+            uint64_t distance = next_tag - last_tag_offset;
+            if (distance < (uint64_t)d_sps && d_corr_est < last_tag_value) {
+                is_fake_tag = true;
+            }
+        }
+
+        if (!is_fake_tag) {
+            // 用 time_est 把符号中心对准到 标签位置 + 小数偏移
+            double t_int = std::floor(time_est);
+            d_next_sym = (uint64_t)((int64_t)next_tag + (int64_t)t_int);
+            d_mu = (float)(time_est - t_int);
+            d_omega = (float)d_sps;
+            d_have_last = false;
+            d_is_synced = true;
+            d_pending_tag = true;
+            d_pending_val = pmt_val;
+            d_pending_corr = found_corr;
+            d_pending_corr_val = corr_val;
+
+            last_tag_offset = next_tag;
+            if (found_corr) {
+                last_tag_value = d_corr_est;
+            }
+        }
+
+        while (tag_it != tags.end() && tag_it->offset == next_tag) {
+            ++tag_it;
+        }
+        d_tag_floor = next_tag + 1;
+    }
+
+    // 只消耗到下一个符号中心之前 lookback() 个样点，留给插值窗口和 Gardner 中点
+    uint64_t keep = n_end;
+    if (d_is_synced) {
+        keep = std::min(keep, d_next_sym);
+    }
+    if (tag_it != tags.end()) {
+        keep = std::min(keep, tag_it->offset);
+    }
+    int64_t nconsume = (int64_t)keep - (int64_t)n0 - lookback();
+    nconsume = std::max<int64_t>(0, std::min<int64_t>(ninput, nconsume));
+    consume_each((int)nconsume);
+    return nproduced;
+}
+
 } // namespace freq_hopping
 } // namespace gr
@@ -8,6 +8,7 @@
 #ifndef INCLUDED_FREQ_HOPPING_SYMBOL_RECOVER_IMPL_H
 #define INCLUDED_FREQ_HOPPING_SYMBOL_RECOVER_IMPL_H
 
+#include <gnuradio/filter/mmse_fir_interpolator_cc.h>
 #include <gnuradio/freq_hopping/symbol_recover.h>
 
 namespace gr {
@@ -21,14 +22,45 @@ private:
     float d_phase_corr;    // 当前相位补偿值
     bool d_is_synced;      // 是否已实现初始同步
     pmt::pmt_t d_tag_key;  // 目标标签名称 "phase_est"
+    pmt::pmt_t d_corr_key; // 相关峰标签名称 "corr_est"
 
     uint64_t last_tag_offset;
     float last_tag_value;
 
+    // 分数定时模式（interpolate = true）
+    bool d_interpolate;
+    gr::filter::mmse_fir_interpolator_cc d_interp;
+    pmt::pmt_t d_time_key;      // 小数定时标签名称 "time_est"
+    float d_gain_mu;            // Gardner 相位增益
+    float d_gain_omega;         // Gardner 频率增益
+    float d_omega;              // 当前每符号采样点数（跟踪时钟偏差）
+    float d_omega_lim;          // d_omega 相对 d_sps 的最大偏移
+    float d_mu;                 // 下一个符号中心的小数部分
+    uint64_t d_next_sym;        // 下一个符号中心的整数部分（输入绝对 offset）
+    uint64_t d_tag_floor;       // 小于该 offset 的 phase_est 标签已经处理过
+    gr_complex d_last_sym;      // 上一个输出符号，Gardner 用
+    bool d_have_last;
+    bool d_pending_tag;         // 下一个输出符号需要转发 phase_est 标签
+    pmt::pmt_t d_pending_val;
+    bool d_pending_corr;        // 同时转发 corr_est 标签
+    pmt::pmt_t d_pending_corr_val;
+
+    int lookback() const;
+    int general_work_interp(int noutput_items,
+                            gr_vector_int& ninput_items,
+                            gr_vector_const_void_star& input_items,
+                            gr_vector_void_star& output_items);
+
+    // 两个标签之间的快速路径：每隔 sps 个输入点取一个，共取 n 个
+    static void copy_strided(gr_complex* out, const gr_complex* in, int sps, int n);
+
 public:
-    symbol_recover_impl(int sps);
+    symbol_recover_impl(int sps, bool interpolate, float ted_gain);
     ~symbol_recover_impl();
 
+    // 当前跟踪到的每符号采样点数（插值模式），供测试检查环路收敛
+    float omega() const { return d_omega; }
+
     // Where all the action really happens
     void forecast(int noutput_items, gr_vector_int& ninput_items_required);
 
@@ -0,0 +1,114 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 lc.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/freq_hopping/time_source.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+
+namespace gr {
+namespace freq_hopping {
+
+namespace {
+
+// 主机时钟
+class host_time_source : public time_source
+{
+public:
+    uint64_t now_ns() override
+    {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+
+    source_type type() const override { return HOST; }
+};
+
+// 设备时钟：记录最近一次设备时间及其到达时的主机单调时钟，之后按单调时钟外推
+class device_time_source : public time_source
+{
+private:
+    mutable std::mutex d_mutex;
+    bool d_valid = false;
+    uint64_t d_device_ns = 0;
+    std::chrono::steady_clock::time_point d_host_at_set;
+
+public:
+    uint64_t now_ns() override
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_valid) {
+            return 0;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - d_host_at_set;
+        return d_device_ns +
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    source_type type() const override { return DEVICE; }
+
+    bool valid() const override
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_valid;
+    }
+
+    void set_time(uint64_t time_ns) override
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_device_ns = time_ns;
+        d_host_at_set = std::chrono::steady_clock::now();
+        d_valid = true;
+    }
+};
+
+// 虚拟时钟：只由 set_time 改变
+class simulated_time_source : public time_source
+{
+private:
+    std::atomic<uint64_t> d_now_ns;
+
+public:
+    explicit simulated_time_source(uint64_t start_ns) : d_now_ns(start_ns) {}
+
+    uint64_t now_ns() override { return d_now_ns.load(); }
+    source_type type() const override { return SIMULATED; }
+    void set_time(uint64_t time_ns) override { d_now_ns.store(time_ns); }
+};
+
+} // namespace
+
+time_source::~time_source() {}
+
+time_source::sptr time_source::make(source_type type, uint64_t start_ns)
+{
+    switch (type) {
+    case HOST:
+        return make_host();
+    case DEVICE:
+        return make_device();
+    case SIMULATED:
+        return make_simulated(start_ns);
+    }
+    throw std::invalid_argument("time_source: unknown source type");
+}
+
+time_source::sptr time_source::make_host() { return std::make_shared<host_time_source>(); }
+
+time_source::sptr time_source::make_device()
+{
+    return std::make_shared<device_time_source>();
+}
+
+time_source::sptr time_source::make_simulated(uint64_t start_ns)
+{
+    return std::make_shared<simulated_time_source>(start_ns);
+}
+
+} // namespace freq_hopping
+} // namespace gr
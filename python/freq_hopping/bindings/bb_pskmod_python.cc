@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(bb_pskmod.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(25fb0fd68c387412386a664bb8a9c261)                     */
+/* BINDTOOL_HEADER_FILE_HASH(008e7026ae149c8055ab7e2ac7236930)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -37,6 +37,10 @@ void bind_bb_pskmod(py::module& m)
         std::shared_ptr<bb_pskmod>>(m, "bb_pskmod", D(bb_pskmod))
 
         .def(py::init(&bb_pskmod::make),
+           py::arg("hop_rate") = 5,
+           py::arg("M_order") = 4,
+           py::arg("Ksa_ch") = 4,
+           py::arg("streaming") = false,
            D(bb_pskmod,make)
         )
         
@@ -24,4 +24,13 @@
 
  static const char *__doc_gr_freq_hopping_hop_demod_make = R"doc()doc";
 
+
+ static const char *__doc_gr_freq_hopping_hop_demod_discontinuities = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_demod_lost_samples = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_demod_dropped_hops = R"doc()doc";
+
   
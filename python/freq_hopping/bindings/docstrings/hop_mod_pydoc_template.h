@@ -24,4 +24,7 @@
 
  static const char *__doc_gr_freq_hopping_hop_mod_make = R"doc()doc";
 
+
+ static const char *__doc_gr_freq_hopping_hop_mod_set_time_source = R"doc()doc";
+
   
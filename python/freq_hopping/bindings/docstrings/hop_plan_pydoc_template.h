@@ -0,0 +1,78 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,freq_hopping, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_freq_hopping_hop_plan = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_make = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_num_channels = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_frequencies = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_frequency = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_hop_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_hop_period = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_rate_num = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_rate_den = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_ns = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_key = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_channel = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_frequency = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_index = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_offset_ns = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_start_ns = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_first_tx_slot = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_slot_at_or_after = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_to_ns = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_hop_plan_ns_since_midnight = R"doc()doc";
+
+  
@@ -24,4 +24,25 @@
 
  static const char *__doc_gr_freq_hopping_ser_measurement_make = R"doc()doc";
 
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_total_frames = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_total_symbols = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_total_errors = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_average_ser = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_short_frames = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_overlong_frames = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_ser_measurement_ser_histogram = R"doc()doc";
+
   
@@ -24,4 +24,10 @@
 
  static const char *__doc_gr_freq_hopping_slot_frame_make = R"doc()doc";
 
+
+ static const char *__doc_gr_freq_hopping_slot_frame_payload_hops = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_slot_frame_idle_hops = R"doc()doc";
+
   
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,freq_hopping, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_freq_hopping_time_source = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_make = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_make_host = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_make_device = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_make_simulated = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_now_ns = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_type = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_valid = R"doc()doc";
+
+
+ static const char *__doc_gr_freq_hopping_time_source_set_time = R"doc()doc";
+
+  
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(frame_recover.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(07ec2e8c24779614c253bfa008888b11)                     */
+/* BINDTOOL_HEADER_FILE_HASH(f60eb34d08b70263bb35aa6f68471781)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -37,6 +37,8 @@ void bind_frame_recover(py::module& m)
         std::shared_ptr<frame_recover>>(m, "frame_recover", D(frame_recover))
 
         .def(py::init(&frame_recover::make),
+           py::arg("frame_len") = 1,
+           py::arg("emit_pdu") = false,
            D(frame_recover,make)
         )
         
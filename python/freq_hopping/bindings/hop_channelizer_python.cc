@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(hop_channelizer.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(d5195d0683383a2204da56f790443f32)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/freq_hopping/hop_channelizer.h>
+// pydoc.h is automatically generated in the build directory
+#include <hop_channelizer_pydoc.h>
+
+void bind_hop_channelizer(py::module& m)
+{
+
+    using hop_channelizer    = ::gr::freq_hopping::hop_channelizer;
+
+
+    py::class_<hop_channelizer, gr::sync_decimator, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<hop_channelizer>>(m, "hop_channelizer", D(hop_channelizer))
+
+        .def(py::init(&hop_channelizer::make),
+           py::arg("bw_hop") = 12000,
+           py::arg("ch_sep") = 3000,
+           py::arg("freq_carrier") = 0,
+           py::arg("fsa_hop") = 12000,
+           py::arg("hop_rate") = 5,
+           py::arg("decim") = 1,
+           py::arg("seq_offsets") = std::vector<int>(1, 0),
+           py::arg("key") = gr::freq_hopping::hop_plan::DEFAULT_KEY,
+           D(hop_channelizer,make)
+        )
+        
+
+
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
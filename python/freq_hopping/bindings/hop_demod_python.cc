@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(hop_demod.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(79c15b2fff8005a745c9b86e8fadd3d7)                     */
+/* BINDTOOL_HEADER_FILE_HASH(e92a02691f16b6199bf9635e2a44dcbd)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -33,7 +33,7 @@ void bind_hop_demod(py::module& m)
     using hop_demod    = ::gr::freq_hopping::hop_demod;
 
 
-    py::class_<hop_demod, gr::sync_block, gr::block, gr::basic_block,
+    py::class_<hop_demod, gr::sync_decimator, gr::sync_block, gr::block, gr::basic_block,
         std::shared_ptr<hop_demod>>(m, "hop_demod", D(hop_demod))
 
         .def(py::init(&hop_demod::make),
@@ -42,8 +42,28 @@ void bind_hop_demod(py::module& m)
            py::arg("freq_carrier") = 0,
            py::arg("fsa_hop") = 12000,
            py::arg("hop_rate") = 5,
+           py::arg("use_phasor_table") = false,
+           py::arg("decim") = 1,
+           py::arg("simulated_time") = false,
+           py::arg("emit_hop_tags") = false,
+           py::arg("key") = gr::freq_hopping::hop_plan::DEFAULT_KEY,
            D(hop_demod,make)
         )
+
+
+        .def("discontinuities",&hop_demod::discontinuities,
+            D(hop_demod,discontinuities)
+        )
+
+
+        .def("lost_samples",&hop_demod::lost_samples,
+            D(hop_demod,lost_samples)
+        )
+
+
+        .def("dropped_hops",&hop_demod::dropped_hops,
+            D(hop_demod,dropped_hops)
+        )
         
 
 
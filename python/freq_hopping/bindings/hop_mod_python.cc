@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(hop_mod.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(c4519f26775bf3f63b46e7b8e2fae097)                     */
+/* BINDTOOL_HEADER_FILE_HASH(45d19d0e6cf1f8111b62ca8f2c598159)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -24,6 +24,7 @@
 namespace py = pybind11;
 
 #include <gnuradio/freq_hopping/hop_mod.h>
+#include <gnuradio/freq_hopping/time_source.h>
 // pydoc.h is automatically generated in the build directory
 #include <hop_mod_pydoc.h>
 
@@ -43,8 +44,19 @@ void bind_hop_mod(py::module& m)
            py::arg("fsa_hop") = 12000,
            py::arg("hop_rate") = 5,
            py::arg("vlen") = 1,
+           py::arg("use_phasor_table") = false,
+           py::arg("clock") = static_cast<int>(gr::freq_hopping::time_source::HOST),
+           py::arg("lead_time") = 0,
+           py::arg("epoch") = 0,
+           py::arg("key") = gr::freq_hopping::hop_plan::DEFAULT_KEY,
            D(hop_mod,make)
         )
+
+
+        .def("set_time_source",&hop_mod::set_time_source,
+           py::arg("source"),
+            D(hop_mod,set_time_source)
+        )
         
 
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(hop_plan.h)                                               */
+/* BINDTOOL_HEADER_FILE_HASH(544ddbd9f527a14b0f2b64683192c5a2)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/freq_hopping/hop_plan.h>
+// pydoc.h is automatically generated in the build directory
+#include <hop_plan_pydoc.h>
+
+void bind_hop_plan(py::module& m)
+{
+
+    using hop_plan    = gr::freq_hopping::hop_plan;
+
+
+    py::class_<hop_plan,
+        std::shared_ptr<hop_plan>>(m, "hop_plan", D(hop_plan))
+
+        .def(py::init(&hop_plan::make),
+           py::arg("bw_hop"),
+           py::arg("ch_sep"),
+           py::arg("freq_carrier"),
+           py::arg("hop_rate"),
+           py::arg("key") = hop_plan::DEFAULT_KEY,
+           D(hop_plan,make)
+        )
+
+
+        .def("num_channels",&hop_plan::num_channels,
+            D(hop_plan,num_channels)
+        )
+
+
+        .def("frequencies",&hop_plan::frequencies,
+            D(hop_plan,frequencies)
+        )
+
+
+        .def("frequency",&hop_plan::frequency,
+           py::arg("ch"),
+            D(hop_plan,frequency)
+        )
+
+
+        .def("hop_rate",&hop_plan::hop_rate,
+            D(hop_plan,hop_rate)
+        )
+
+
+        .def("hop_period",&hop_plan::hop_period,
+            D(hop_plan,hop_period)
+        )
+
+
+        .def("rate_num",&hop_plan::rate_num,
+            D(hop_plan,rate_num)
+        )
+
+
+        .def("rate_den",&hop_plan::rate_den,
+            D(hop_plan,rate_den)
+        )
+
+
+        .def("slot_ns",&hop_plan::slot_ns,
+            D(hop_plan,slot_ns)
+        )
+
+
+        .def("key",&hop_plan::key,
+            D(hop_plan,key)
+        )
+
+
+        .def("channel",&hop_plan::channel,
+           py::arg("slot"),
+            D(hop_plan,channel)
+        )
+
+
+        .def("slot_frequency",&hop_plan::slot_frequency,
+           py::arg("slot"),
+            D(hop_plan,slot_frequency)
+        )
+
+
+        .def("slot_index",&hop_plan::slot_index,
+           py::arg("time_ns"),
+            D(hop_plan,slot_index)
+        )
+
+
+        .def("slot_offset_ns",&hop_plan::slot_offset_ns,
+           py::arg("time_ns"),
+            D(hop_plan,slot_offset_ns)
+        )
+
+
+        .def("slot_start_ns",&hop_plan::slot_start_ns,
+           py::arg("time_ns"),
+           py::arg("slot"),
+            D(hop_plan,slot_start_ns)
+        )
+
+
+        .def("first_tx_slot",&hop_plan::first_tx_slot,
+           py::arg("time_ns"),
+            D(hop_plan,first_tx_slot)
+        )
+
+
+        .def("slot_at_or_after",&hop_plan::slot_at_or_after,
+           py::arg("time_ns"),
+            D(hop_plan,slot_at_or_after)
+        )
+
+
+        .def_static("to_ns",&hop_plan::to_ns,
+           py::arg("sec"),
+           py::arg("frac_sec"),
+            D(hop_plan,to_ns)
+        )
+
+
+        .def_static("ns_since_midnight",&hop_plan::ns_since_midnight,
+           py::arg("time_ns"),
+            D(hop_plan,ns_since_midnight)
+        )
+
+        ;
+
+
+
+
+}
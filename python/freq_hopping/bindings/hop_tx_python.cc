@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(hop_tx.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(e8bcd0c5afdb7bb4d64bd429fd8747ba)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/freq_hopping/hop_tx.h>
+// pydoc.h is automatically generated in the build directory
+#include <hop_tx_pydoc.h>
+
+void bind_hop_tx(py::module& m)
+{
+
+    using hop_tx    = ::gr::freq_hopping::hop_tx;
+
+
+    py::class_<hop_tx, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<hop_tx>>(m, "hop_tx", D(hop_tx))
+
+        .def(py::init(&hop_tx::make),
+           py::arg("hop_rate") = 20,
+           py::arg("M_order") = 4,
+           py::arg("Ksa_ch") = 4,
+           py::arg("interp_fac") = 256,
+           py::arg("bw_hop") = 1e6,
+           py::arg("ch_sep") = 3e3,
+           py::arg("freq_carrier") = 500e3,
+           py::arg("fsa_hop") = 2457600,
+           py::arg("clock") = static_cast<int>(gr::freq_hopping::time_source::HOST),
+           py::arg("lead_time") = 0,
+           py::arg("epoch") = 0,
+           py::arg("key") = gr::freq_hopping::hop_plan::DEFAULT_KEY,
+           D(hop_tx,make)
+        )
+
+
+        .def("set_time_source",&hop_tx::set_time_source,
+           py::arg("source"),
+            D(hop_tx,set_time_source)
+        )
+        
+
+
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -29,6 +29,10 @@ namespace py = pybind11;
     void bind_symbol_recover(py::module& m);
     void bind_frame_recover(py::module& m);
     void bind_ser_measurement(py::module& m);
+    void bind_hop_channelizer(py::module& m);
+    void bind_hop_tx(py::module& m);
+    void bind_hop_plan(py::module& m);
+    void bind_time_source(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
 
 
@@ -65,5 +69,9 @@ PYBIND11_MODULE(freq_hopping_python, m)
     bind_symbol_recover(m);
     bind_frame_recover(m);
     bind_ser_measurement(m);
+    bind_hop_channelizer(m);
+    bind_hop_tx(m);
+    bind_hop_plan(m);
+    bind_time_source(m);
     // ) END BINDING_FUNCTION_CALLS
 }
\ No newline at end of file
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ser_measurement.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(5c1122c4512ba3c2a228d90eee67448f)                     */
+/* BINDTOOL_HEADER_FILE_HASH(8278871323bbee58b43c023f08b145cd)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -37,8 +37,46 @@ void bind_ser_measurement(py::module& m)
         std::shared_ptr<ser_measurement>>(m, "ser_measurement", D(ser_measurement))
 
         .def(py::init(&ser_measurement::make),
+           py::arg("filename"),
+           py::arg("frame_len") = 0,
+           py::arg("verbose") = false,
            D(ser_measurement,make)
         )
+
+
+        .def("total_frames",&ser_measurement::total_frames,
+            D(ser_measurement,total_frames)
+        )
+
+
+        .def("total_symbols",&ser_measurement::total_symbols,
+            D(ser_measurement,total_symbols)
+        )
+
+
+        .def("total_errors",&ser_measurement::total_errors,
+            D(ser_measurement,total_errors)
+        )
+
+
+        .def("average_ser",&ser_measurement::average_ser,
+            D(ser_measurement,average_ser)
+        )
+
+
+        .def("short_frames",&ser_measurement::short_frames,
+            D(ser_measurement,short_frames)
+        )
+
+
+        .def("overlong_frames",&ser_measurement::overlong_frames,
+            D(ser_measurement,overlong_frames)
+        )
+
+
+        .def("ser_histogram",&ser_measurement::ser_histogram,
+            D(ser_measurement,ser_histogram)
+        )
         
 
 
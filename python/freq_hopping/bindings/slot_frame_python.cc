@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(slot_frame.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(ec99b20d3919bf6f1a4409134ecdeff6)                     */
+/* BINDTOOL_HEADER_FILE_HASH(6fd111557b8108c6466f13e69ad9495a)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -33,14 +33,28 @@ void bind_slot_frame(py::module& m)
     using slot_frame    = gr::freq_hopping::slot_frame;
 
 
-    py::class_<slot_frame, gr::sync_block, gr::block, gr::basic_block,
+    py::class_<slot_frame, gr::block, gr::basic_block,
         std::shared_ptr<slot_frame>>(m, "slot_frame", D(slot_frame))
 
         .def(py::init(&slot_frame::make),
+           py::arg("hop_rate") = 20,
+           py::arg("M_order") = 4,
+           py::arg("info_seed") = 0,
+           py::arg("payload_input") = false,
+           py::arg("max_buffered_hops") = 16,
            D(slot_frame,make)
         )
         
 
+        .def("payload_hops",&slot_frame::payload_hops,
+            D(slot_frame,payload_hops)
+        )
+
+
+        .def("idle_hops",&slot_frame::idle_hops,
+            D(slot_frame,idle_hops)
+        )
+
 
 
         ;
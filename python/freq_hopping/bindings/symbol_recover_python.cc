@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(symbol_recover.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(4a2fd18a1e062f659fc2afedc97d44af)                     */
+/* BINDTOOL_HEADER_FILE_HASH(38622f3f9117badf1fdf04441dfb47e2)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -37,6 +37,9 @@ void bind_symbol_recover(py::module& m)
         std::shared_ptr<symbol_recover>>(m, "symbol_recover", D(symbol_recover))
 
         .def(py::init(&symbol_recover::make),
+           py::arg("sps") = 1,
+           py::arg("interpolate") = false,
+           py::arg("ted_gain") = 0.05,
            D(symbol_recover,make)
         )
         
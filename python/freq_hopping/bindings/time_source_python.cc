@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(time_source.h)                                            */
+/* BINDTOOL_HEADER_FILE_HASH(def48af23382e4a1a1629af2531a6b74)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/freq_hopping/time_source.h>
+// pydoc.h is automatically generated in the build directory
+#include <time_source_pydoc.h>
+
+void bind_time_source(py::module& m)
+{
+
+    using time_source    = gr::freq_hopping::time_source;
+
+
+    py::class_<time_source,
+        std::shared_ptr<time_source>> time_source_class(m, "time_source", D(time_source));
+
+    py::enum_<time_source::source_type>(time_source_class, "source_type")
+        .value("HOST", time_source::HOST)
+        .value("DEVICE", time_source::DEVICE)
+        .value("SIMULATED", time_source::SIMULATED)
+        .export_values();
+
+    time_source_class
+
+        .def_static("make",&time_source::make,
+           py::arg("type"),
+           py::arg("start_ns") = 0,
+            D(time_source,make)
+        )
+
+
+        .def_static("make_host",&time_source::make_host,
+            D(time_source,make_host)
+        )
+
+
+        .def_static("make_device",&time_source::make_device,
+            D(time_source,make_device)
+        )
+
+
+        .def_static("make_simulated",&time_source::make_simulated,
+           py::arg("start_ns") = 0,
+            D(time_source,make_simulated)
+        )
+
+
+        .def("now_ns",&time_source::now_ns,
+            D(time_source,now_ns)
+        )
+
+
+        .def("type",&time_source::type,
+            D(time_source,type)
+        )
+
+
+        .def("valid",&time_source::valid,
+            D(time_source,valid)
+        )
+
+
+        .def("set_time",&time_source::set_time,
+           py::arg("time_ns"),
+            D(time_source,set_time)
+        )
+
+        ;
+
+
+
+
+}